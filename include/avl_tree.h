@@ -2,55 +2,160 @@
 #define DS_GRAPH_AVL_TREE_H
 
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
 #include "binary_search_tree.h"
 
 
 namespace dsl::nonlinear::tree
 {
-    template <Comparable Tp>
-    class avl_tree : public binary_search_tree<Tp>
+    namespace details
+    {
+        template <Comparable Tp>
+        struct avl_node : public bitree_node<Tp>
+        {
+            constexpr explicit avl_node(const Tp &value) noexcept
+                : bitree_node<Tp>(value),
+                  m_height(1),
+                  m_count(1) {}
+
+            constexpr explicit avl_node(Tp &&value) noexcept(std::is_nothrow_move_constructible_v<Tp>)
+                : bitree_node<Tp>(std::move(value)),
+                  m_height(1),
+                  m_count(1) {}
+
+            ~avl_node() noexcept = default;
+
+            [[nodiscard]] std::size_t footprint() const noexcept override
+            { return sizeof(avl_node); }
+
+            [[nodiscard]] bitree_node<Tp>* clone_into(void *const where) const override
+            { return this->copy_of(*this, where); }
+
+            int m_height;   // levels in the subtree rooted here (a leaf has height 1)
+            int m_count;    // nodes in the subtree rooted here
+
+        };  // struct avl_node
+
+    }   // namespace details
+
+
+
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare = three_way_compare>
+    class avl_tree : public binary_search_tree<Tp, Compare>
     {
     public:
-        using bitree_node = typename binary_search_tree<Tp>::bitree_node;
+        using bitree_node = typename binary_search_tree<Tp, Compare>::bitree_node;
+        using avl_node = typename details::avl_node<Tp>;
 
 
         //****** Member Functions ******//
 
         // No-throw Constructor
         avl_tree() noexcept
-            : binary_search_tree<Tp>() {}
+            : binary_search_tree<Tp, Compare>() {}
 
         // Copy constructor
         avl_tree(const avl_tree &rhs)
-            : binary_search_tree<Tp>(rhs) {}
+            : binary_search_tree<Tp, Compare>(rhs) {}
 
         // Move constructor
         avl_tree(avl_tree &&rhs) noexcept
-            : binary_search_tree<Tp>(rhs) {}
+            : binary_search_tree<Tp, Compare>(std::move(rhs)) {}
 
         // Pass-by-value copy/move assignment
         avl_tree& operator=(avl_tree rhs) noexcept
-        { binary_search_tree<Tp>::operator=(rhs); return *this; }
+        { binary_search_tree<Tp, Compare>::operator=(std::move(rhs)); return *this; }
 
         ~avl_tree() = default;
 
+        // Builds a perfectly balanced (hence AVL-balanced) tree in O(n) from a sorted range of unique keys
+        template <std::random_access_iterator It>
+        [[nodiscard]] static avl_tree from_sorted(It first, It last)
+        { avl_tree t; t.assign_sorted(first, last, false); return t; }
+
+        // As from_sorted, building the left and right subtrees of large ranges concurrently
+        template <std::random_access_iterator It>
+        [[nodiscard]] static avl_tree from_sorted_parallel(It first, It last)
+        { avl_tree t; t.assign_sorted(first, last, true); return t; }
+
 
         //****** Access ******//
         [[nodiscard]] constexpr int balanceOf(bitree_node*) const noexcept;
 
 
+        //****** Order Statistics ******//
+        [[nodiscard]] constexpr const Tp& select(int) const;     // throws if index is out of range
+        template <typename Kp = Tp> requires ThreeWayComparator<Compare, Kp, Tp>
+        [[nodiscard]] constexpr int rank(const Kp&) const noexcept;
+        [[nodiscard]] constexpr int count_range(const Tp&, const Tp&) const noexcept;
+
+
         //****** Modifiers ******//
         constexpr bool push(const Tp&) override;
+        constexpr bool push(Tp&&) override;
         constexpr bool pop(const Tp&) override;
 
 
+        //****** Set Operations ******//
+        // Each operation consumes its argument (pass with std::move to avoid a copy)
+        [[nodiscard]] avl_tree split(const Tp&);
+        void join(avl_tree);
+        void union_with(avl_tree);
+        void intersect_with(avl_tree);
+        void difference_with(avl_tree);
+
+
+    protected:
+        [[nodiscard]] bitree_node* make_node(const Tp &value) const override
+        { return this->template create_node<avl_node>(value); }
+
+        [[nodiscard]] bitree_node* make_node(Tp &&value) const override
+        { return this->template create_node<avl_node>(std::move(value)); }
+
+        constexpr void refresh(bitree_node*) const noexcept override;
+
+        [[nodiscard]] static constexpr int height(const bitree_node *const node) noexcept
+        { return (node == nullptr) ? 0 : static_cast<const avl_node*>(node)->m_height; }
+
+        [[nodiscard]] static constexpr int count(const bitree_node *const node) noexcept
+        { return (node == nullptr) ? 0 : static_cast<const avl_node*>(node)->m_count; }
+
+
     private:
-        constexpr void rotate_left(bitree_node*, bool);
-        constexpr void rotate_right(bitree_node*, bool);
-        constexpr void rotate_left_right(bitree_node*, bool);
-        constexpr void rotate_right_left(bitree_node*, bool);
-        constexpr void update_balance(std::stack<bitree_node*>&) noexcept;
+        // Result of splitting a subtree around a key; match is the detached node holding the key, if any
+        struct split_result
+        {
+            bitree_node *m_left = nullptr, *m_match = nullptr, *m_right = nullptr;
+        };
+
+        constexpr bitree_node* rotate_left(bitree_node*) const noexcept;
+        constexpr bitree_node* rotate_right(bitree_node*) const noexcept;
+        constexpr bitree_node* rebalance(bitree_node*) const noexcept;
+
+        template <typename Vp>
+        bitree_node* insert(bitree_node*, Vp&&, bool&);
+        bitree_node* erase(bitree_node*, const Tp&, bool&);
+        bitree_node* detach_min(bitree_node*, bitree_node*&) const noexcept;
+        bitree_node* detach_max(bitree_node*, bitree_node*&) const noexcept;
+
+        bitree_node* join(bitree_node*, bitree_node*, bitree_node*) const noexcept;
+        bitree_node* join(bitree_node*, bitree_node*) const noexcept;
+        split_result split(bitree_node*, const Tp&) const noexcept;
+
+        bitree_node* unite(bitree_node*, bitree_node*) const;
+        bitree_node* intersect(bitree_node*, bitree_node*) const;
+        bitree_node* subtract(bitree_node*, bitree_node*) const;
+
+        template <typename Kp>
+        constexpr int count_less(const Kp&, bool) const noexcept;
+        void adopt(bitree_node*) noexcept;
 
     }; // class avl_tree
 
@@ -60,157 +165,479 @@ namespace dsl::nonlinear::tree
 
 
     // Determines left-to-right balance of one of the nodes in the tree
-    template <Comparable Tp>
-    constexpr int avl_tree<Tp>::balanceOf(bitree_node *const root) const noexcept
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    constexpr int avl_tree<Tp, Compare>::balanceOf(bitree_node *const root) const noexcept
     {
         if (root == nullptr) return 0;
-        return depth(root->m_left) - depth(root->m_right);
+        return height(root->m_left) - height(root->m_right);
     }
 
 
-    // Performs left rotation and returns new root at the rotation scope
-    template <Comparable Tp>
-    constexpr void avl_tree<Tp>::rotate_left(bitree_node *parent, const bool isLeft)
+    // Returns the key with the given zero-based position in sorted order, in O(log n)
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    constexpr const Tp& avl_tree<Tp, Compare>::select(int index) const
     {
-        if (parent == nullptr)
+        if (index < 0 || index >= this->m_size)
+            throw std::out_of_range("Cannot select a key at an index outside the tree.");
+
+        auto *curr = this->m_root;
+        while (true)
         {
-            auto *root = this->m_root;
-            auto *temp = root->m_right;
-            root->m_right = temp->m_left;
-            temp->m_left = root;
-            root = temp;
+            const auto left = count(curr->m_left);
+            if (index == left)
+                return curr->m_value;
+
+            if (index < left)
+                curr = curr->m_left;
+            else
+            {
+                index -= left + 1;
+                curr = curr->m_right;
+            }
         }
-        else
-        {
-            auto *unb = (isLeft) ? parent->m_left : parent->m_right;
-            auto *temp = unb->m_right;
-            unb->m_right = temp->m_left;
-            temp->m_left = unb;
+    }
 
-            if (isLeft)
-                parent->m_left = temp;
+
+    // Returns the number of keys less than value, in O(log n)
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    template <typename Kp> requires ThreeWayComparator<Compare, Kp, Tp>
+    constexpr int avl_tree<Tp, Compare>::rank(const Kp &value) const noexcept
+    { return count_less(value, false); }
+
+
+    // Returns the number of keys in the closed range [lo, hi], in O(log n)
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    constexpr int avl_tree<Tp, Compare>::count_range(const Tp &lo, const Tp &hi) const noexcept
+    { return (this->compare(hi, lo) < 0) ? 0 : count_less(hi, true) - count_less(lo, false); }
+
+
+    // Counts the keys less than (or, if inclusive, not greater than) value along one root-to-leaf path
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    template <typename Kp>
+    constexpr int avl_tree<Tp, Compare>::count_less(const Kp &value, const bool inclusive) const noexcept
+    {
+        auto result = 0;
+        auto *curr = this->m_root;
+        while (curr != nullptr)
+        {
+            const auto order = this->compare(value, curr->m_value);
+            if (order > 0 || (inclusive && order == 0))
+            {
+                result += count(curr->m_left) + 1;
+                curr = curr->m_right;
+            }
             else
-                parent->m_right = temp;
+                curr = curr->m_left;
         }
+        return result;
+    }
+
+
+    // Recomputes the height and size of a node from its children
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    constexpr void avl_tree<Tp, Compare>::refresh(bitree_node *const node) const noexcept
+    {
+        auto *n = static_cast<avl_node*>(node);
+        n->m_height = 1 + std::max(height(node->m_left), height(node->m_right));
+        n->m_count = 1 + count(node->m_left) + count(node->m_right);
+    }
+
+
+    // Performs left rotation and returns new root at the rotation scope
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    constexpr typename avl_tree<Tp, Compare>::bitree_node*
+    avl_tree<Tp, Compare>::rotate_left(bitree_node *const node) const noexcept
+    {
+        auto *pivot = node->m_right;
+        node->m_right = pivot->m_left;
+        pivot->m_left = node;
+
+        this->refresh(node);
+        this->refresh(pivot);
+        return pivot;
     }
 
 
     // Performs right rotation and returns new root at the rotation scope
-    template <Comparable Tp>
-    constexpr void avl_tree<Tp>::rotate_right(bitree_node *parent, const bool isLeft)
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    constexpr typename avl_tree<Tp, Compare>::bitree_node*
+    avl_tree<Tp, Compare>::rotate_right(bitree_node *const node) const noexcept
     {
-        if (parent == nullptr)
+        auto *pivot = node->m_left;
+        node->m_left = pivot->m_right;
+        pivot->m_right = node;
+
+        this->refresh(node);
+        this->refresh(pivot);
+        return pivot;
+    }
+
+
+    // Restores the AVL invariant at a node whose subtrees differ in height by at most 2
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    constexpr typename avl_tree<Tp, Compare>::bitree_node*
+    avl_tree<Tp, Compare>::rebalance(bitree_node *const node) const noexcept
+    {
+        this->refresh(node);
+        const auto balance = balanceOf(node);
+
+        if (balance > 1)
         {
-            auto *root = this->m_root;
-            auto *temp = root->m_left;
-            root->m_left = temp->m_right;
-            temp->m_right = root;
-            root = temp;
+            if (balanceOf(node->m_left) < 0)
+                node->m_left = rotate_left(node->m_left);
+            return rotate_right(node);
         }
+
+        if (balance < -1)
+        {
+            if (balanceOf(node->m_right) > 0)
+                node->m_right = rotate_right(node->m_right);
+            return rotate_left(node);
+        }
+
+        return node;
+    }
+
+
+    // push helper function; returns the new root of the subtree
+    // The value is only forwarded into a node at the bottom, so an rvalue is moved at most once
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    template <typename Vp>
+    typename avl_tree<Tp, Compare>::bitree_node*
+    avl_tree<Tp, Compare>::insert(bitree_node *const root, Vp &&value, bool &inserted)
+    {
+        if (root == nullptr)
+        {
+            inserted = true;
+            return this->make_node(std::forward<Vp>(value));
+        }
+
+        const auto order = this->compare(value, root->m_value);
+        if (order == 0)
+            return root;
+
+        if (order < 0)
+            root->m_left = insert(root->m_left, std::forward<Vp>(value), inserted);
+        else
+            root->m_right = insert(root->m_right, std::forward<Vp>(value), inserted);
+
+        return (inserted) ? rebalance(root) : root;
+    }
+
+
+    // pop helper function; returns the new root of the subtree
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    typename avl_tree<Tp, Compare>::bitree_node*
+    avl_tree<Tp, Compare>::erase(bitree_node *root, const Tp &value, bool &erased)
+    {
+        if (root == nullptr)
+            return nullptr;
+
+        const auto order = this->compare(value, root->m_value);
+        if (order < 0)
+            root->m_left = erase(root->m_left, value, erased);
+        else if (order > 0)
+            root->m_right = erase(root->m_right, value, erased);
         else
         {
-            auto *unb = (isLeft) ? parent->m_left : parent->m_right;
-            auto *temp = unb->m_left;
-            unb->m_left = temp->m_right;
-            temp->m_right = unb;
+            erased = true;
+            auto *target = root;
 
-            if (isLeft)
-                parent->m_left = temp;
+            if (root->m_left == nullptr || root->m_right == nullptr)
+                root = (root->m_left != nullptr) ? root->m_left : root->m_right;
             else
-                parent->m_right = temp;
+            {
+                // Replace the node with its in-order successor
+                bitree_node *successor = nullptr;
+                auto *right = detach_min(root->m_right, successor);
+                successor->m_left = root->m_left;
+                successor->m_right = right;
+                root = successor;
+            }
+
+            delete target;
+            if (root == nullptr)
+                return nullptr;
         }
+
+        return (erased) ? rebalance(root) : root;
     }
 
 
-    template <Comparable Tp>
-    constexpr void avl_tree<Tp>::rotate_left_right(bitree_node *parent, const bool isLeft)
+    // Unlinks the minimum node of a subtree into min; returns the new root of the subtree
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    typename avl_tree<Tp, Compare>::bitree_node*
+    avl_tree<Tp, Compare>::detach_min(bitree_node *const root, bitree_node *&min) const noexcept
     {
-        if (parent == nullptr)
+        if (root->m_left == nullptr)
         {
-            rotate_left(this->m_root, true);
-            rotate_right(nullptr, false);
+            min = root;
+            return root->m_right;
         }
-        else
+        root->m_left = detach_min(root->m_left, min);
+        return rebalance(root);
+    }
+
+
+    // Unlinks the maximum node of a subtree into max; returns the new root of the subtree
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    typename avl_tree<Tp, Compare>::bitree_node*
+    avl_tree<Tp, Compare>::detach_max(bitree_node *const root, bitree_node *&max) const noexcept
+    {
+        if (root->m_right == nullptr)
         {
-            auto *child = (isLeft) ? parent->m_left : parent->m_right;
-            rotate_left(child, true);
-            rotate_right(parent, isLeft);
+            max = root;
+            return root->m_left;
         }
+        root->m_right = detach_max(root->m_right, max);
+        return rebalance(root);
     }
 
 
-    template <Comparable Tp>
-    constexpr void avl_tree<Tp>::rotate_right_left(bitree_node *parent, const bool isLeft)
+    // Joins two subtrees around a middle node whose key lies between them, in O(|height difference|)
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    typename avl_tree<Tp, Compare>::bitree_node*
+    avl_tree<Tp, Compare>::join(bitree_node *const left, bitree_node *const mid, bitree_node *const right) const noexcept
     {
-        if (parent == nullptr)
+        if (height(left) > height(right) + 1)
         {
-            rotate_right(this->m_root, false);
-            rotate_left(nullptr, false);
+            left->m_right = join(left->m_right, mid, right);
+            return rebalance(left);
         }
-        else
+
+        if (height(right) > height(left) + 1)
         {
-            auto *child = (isLeft) ? parent->m_left : parent->m_right;
-            rotate_right(child, isLeft);
-            rotate_left(parent, isLeft);
+            right->m_left = join(left, mid, right->m_left);
+            return rebalance(right);
         }
+
+        mid->m_left = left;
+        mid->m_right = right;
+        this->refresh(mid);
+        return mid;
+    }
+
+
+    // Joins two subtrees where every key on the left is less than every key on the right
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    typename avl_tree<Tp, Compare>::bitree_node*
+    avl_tree<Tp, Compare>::join(bitree_node *left, bitree_node *const right) const noexcept
+    {
+        if (left == nullptr)
+            return right;
+
+        bitree_node *mid = nullptr;
+        left = detach_max(left, mid);
+        return join(left, mid, right);
     }
 
 
-    template <Comparable Tp>
-    constexpr void avl_tree<Tp>::update_balance(std::stack<bitree_node*> &s) noexcept
+    // Splits a subtree into the keys less than and greater than value, detaching the node equal to value
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    typename avl_tree<Tp, Compare>::split_result
+    avl_tree<Tp, Compare>::split(bitree_node *const root, const Tp &value) const noexcept
     {
-        while (!s.empty())
+        if (root == nullptr)
+            return split_result{};
+
+        auto *left = root->m_left, *right = root->m_right;
+        const auto order = this->compare(value, root->m_value);
+        if (order == 0)
+            return split_result{left, root, right};
+
+        if (order < 0)
         {
-            bool isLeft = false;
-            bitree_node *parent = nullptr, *curr = s.top();
-            s.pop();
+            auto s = split(left, value);
+            return split_result{s.m_left, s.m_match, join(s.m_right, root, right)};
+        }
 
-            if (s.empty())
-            {
-                parent = s.top();
-                isLeft = curr->m_value < parent->m_value;
-            }
+        auto s = split(right, value);
+        return split_result{join(left, root, s.m_left), s.m_match, s.m_right};
+    }
 
-            if (abs(balanceOf(curr)) > 1)
-            {
-                if (ld > rd)
-                {
-                    if (balanceOf(curr->m_left) > 0) rotate_right(parent, isLeft);
-                    else rotate_left_right(parent, isLeft);
-                }
-                else
-                {
-                    if (balanceOf(curr->m_right) > 0) rotate_right_left(parent, isLeft);
-                    else rotate_left(parent, isLeft);
-                }
-            }
+
+    // union_with helper function; t1 supplies the pivots, duplicate nodes from t2 are freed
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    typename avl_tree<Tp, Compare>::bitree_node*
+    avl_tree<Tp, Compare>::unite(bitree_node *const t1, bitree_node *const t2) const
+    {
+        if (t1 == nullptr) return t2;
+        if (t2 == nullptr) return t1;
+
+        const auto estimate = count(t1) + count(t2);
+        auto s = split(t2, t1->m_value);
+        delete s.m_match;
+
+        auto *l1 = t1->m_left, *r1 = t1->m_right;
+        bitree_node *left = nullptr, *right = nullptr;
+        this->fork(estimate,
+                   [&] { left = unite(l1, s.m_left); },
+                   [&] { right = unite(r1, s.m_right); });
+        return join(left, t1, right);
+    }
+
+
+    // intersect_with helper function; nodes of t1 without a match in t2 (and all of t2) are freed
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    typename avl_tree<Tp, Compare>::bitree_node*
+    avl_tree<Tp, Compare>::intersect(bitree_node *const t1, bitree_node *const t2) const
+    {
+        if (t1 == nullptr || t2 == nullptr)
+        {
+            this->destroy(t1);
+            this->destroy(t2);
+            return nullptr;
         }
+
+        const auto estimate = count(t1) + count(t2);
+        auto s = split(t2, t1->m_value);
+
+        auto *l1 = t1->m_left, *r1 = t1->m_right;
+        bitree_node *left = nullptr, *right = nullptr;
+        this->fork(estimate,
+                   [&] { left = intersect(l1, s.m_left); },
+                   [&] { right = intersect(r1, s.m_right); });
+
+        if (s.m_match != nullptr)
+        {
+            delete s.m_match;
+            return join(left, t1, right);
+        }
+        delete t1;
+        return join(left, right);
+    }
+
+
+    // difference_with helper function; t2 and the nodes of t1 matched in t2 are freed
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    typename avl_tree<Tp, Compare>::bitree_node*
+    avl_tree<Tp, Compare>::subtract(bitree_node *const t1, bitree_node *const t2) const
+    {
+        if (t1 == nullptr)
+        {
+            this->destroy(t2);
+            return nullptr;
+        }
+        if (t2 == nullptr) return t1;
+
+        const auto estimate = count(t1) + count(t2);
+        auto s = split(t1, t2->m_value);
+        delete s.m_match;
+
+        auto *l2 = t2->m_left, *r2 = t2->m_right;
+        delete t2;
+
+        bitree_node *left = nullptr, *right = nullptr;
+        this->fork(estimate,
+                   [&] { left = subtract(s.m_left, l2); },
+                   [&] { right = subtract(s.m_right, r2); });
+        return join(left, right);
+    }
+
+
+    // Installs a new root, recomputing the size in O(1) from the augmented count
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    void avl_tree<Tp, Compare>::adopt(bitree_node *const root) noexcept
+    {
+        this->m_root = root;
+        this->m_size = count(root);
     }
 
 
     // Inserts a node with the given value and balances the tree
-    template <Comparable Tp>
-    constexpr bool avl_tree<Tp>::push(const Tp &value)
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    constexpr bool avl_tree<Tp, Compare>::push(const Tp &value)
     {
-        if (!binary_search_tree<Tp>::push(value))
-            return false;
+        auto inserted = false;
+        this->m_root = insert(this->m_root, value, inserted);
+        if (inserted)
+            this->m_size++;
+        return inserted;
+    }
 
-        auto s = this->pathTo(value);
-        update_balance(s);
-        return true;
+
+    // As push, moving the value into the new node (only if it is inserted)
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    constexpr bool avl_tree<Tp, Compare>::push(Tp &&value)
+    {
+        auto inserted = false;
+        this->m_root = insert(this->m_root, std::move(value), inserted);
+        if (inserted)
+            this->m_size++;
+        return inserted;
     }
 
 
     // Removes a node with the given value and balances the tree
-    template <Comparable Tp>
-    constexpr bool avl_tree<Tp>::pop(const Tp &value)
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    constexpr bool avl_tree<Tp, Compare>::pop(const Tp &value)
     {
-        auto s = this->pathTo(value);
-        if (!binary_search_tree<Tp>::pop(value))
-            return false;
+        auto erased = false;
+        this->m_root = erase(this->m_root, value, erased);
+        if (erased)
+            this->m_size--;
+        return erased;
+    }
 
-        update_balance(s);
-        return true;
+
+    // Keeps the keys less than value and returns a tree holding the keys greater than or equal to it
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    avl_tree<Tp, Compare> avl_tree<Tp, Compare>::split(const Tp &value)
+    {
+        auto upper = avl_tree{};
+        this->share_slab(upper, false);
+
+        auto s = split(this->m_root, value);
+        if (s.m_match != nullptr)
+            s.m_right = join(nullptr, s.m_match, s.m_right);
+
+        upper.adopt(s.m_right);
+        adopt(s.m_left);
+        return upper;
+    }
+
+
+    // Appends a tree whose keys are all greater than the keys of this tree
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    void avl_tree<Tp, Compare>::join(avl_tree<Tp, Compare> rhs)
+    {
+        if (this->m_root != nullptr && rhs.m_root != nullptr &&
+            !(this->compare(this->maxKey(*this->m_root).m_value, this->minKey(*rhs.m_root).m_value) < 0))
+            throw std::invalid_argument("Cannot join a tree whose keys do not all exceed this tree's keys.");
+
+        this->share_slab(rhs, true);
+        adopt(join(this->m_root, rhs.m_root));
+        rhs.adopt(nullptr);
+    }
+
+
+    // Merges in the keys of another tree in O(m log(n / m + 1)) work, forking on large subtrees
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    void avl_tree<Tp, Compare>::union_with(avl_tree<Tp, Compare> rhs)
+    {
+        this->share_slab(rhs, true);
+        adopt(unite(this->m_root, rhs.m_root));
+        rhs.adopt(nullptr);
+    }
+
+
+    // Keeps only the keys also present in another tree
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    void avl_tree<Tp, Compare>::intersect_with(avl_tree<Tp, Compare> rhs)
+    {
+        this->share_slab(rhs, true);
+        adopt(intersect(this->m_root, rhs.m_root));
+        rhs.adopt(nullptr);
+    }
+
+
+    // Removes the keys present in another tree
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    void avl_tree<Tp, Compare>::difference_with(avl_tree<Tp, Compare> rhs)
+    {
+        this->share_slab(rhs, true);
+        adopt(subtract(this->m_root, rhs.m_root));
+        rhs.adopt(nullptr);
     }
 
 }   // namespace nonlinear::tree
@@ -2,12 +2,21 @@
 #define DS_GRAPH_BINARY_SEARCH_TREE_H
 
 
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
 #include "binary_tree.h"
 
 
 namespace dsl::nonlinear::tree
 {
-    template <Comparable Tp>
+    // Keys are ordered by the Compare policy, which makes one three-way comparison per node visited
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare = three_way_compare>
     class binary_search_tree : public binary_tree<Tp>
     {
     public:
@@ -25,38 +34,105 @@ namespace dsl::nonlinear::tree
 
         // Move constructor
         binary_search_tree(binary_search_tree &&rhs) noexcept
-            : binary_tree<Tp>(rhs) {}
+            : binary_tree<Tp>(std::move(rhs)) {}
 
         // Pass-by-value copy/move assignment
         binary_search_tree& operator=(binary_search_tree rhs) noexcept
-        { binary_tree<Tp>::operator=(rhs); return *this; }
+        { binary_tree<Tp>::operator=(std::move(rhs)); return *this; }
 
         virtual ~binary_search_tree() = default;
 
+        // Builds a perfectly balanced tree in O(n) from a sorted range of unique keys
+        template <std::random_access_iterator It>
+        [[nodiscard]] static binary_search_tree from_sorted(It first, It last)
+        { binary_search_tree t; t.assign_sorted(first, last, false); return t; }
+
+        // As from_sorted, building the left and right subtrees of large ranges concurrently
+        template <std::random_access_iterator It>
+        [[nodiscard]] static binary_search_tree from_sorted_parallel(It first, It last)
+        { binary_search_tree t; t.assign_sorted(first, last, true); return t; }
+
 
         //****** Access ******//
         [[nodiscard]] constexpr const bitree_node& maxKey(const bitree_node&) const noexcept override;
         [[nodiscard]] constexpr const bitree_node& minKey(const bitree_node&) const noexcept override;
 
-        constexpr std::optional<bitree_node&> parentOf(const Tp&) const noexcept override;
-        [[nodiscard]] constexpr std::optional<bitree_node&> parentOf(const bitree_node &node) const noexcept override
-        { return parentOf(node->m_value); }
+        [[nodiscard]] constexpr const bitree_node* parentOf(const Tp&) const noexcept override;
+        [[nodiscard]] constexpr const bitree_node* parentOf(const bitree_node &node) const noexcept override
+        { return parentOf(node.m_value); }
 
-        constexpr std::optional<const bitree_node&> find(const Tp&) const noexcept override;
-        virtual std::optional<std::stack<bitree_node*>> pathTo(const Tp&) const noexcept;
+        [[nodiscard]] constexpr const bitree_node* find(const Tp &value) const noexcept override
+        { return descend(value, nullptr); }
 
-        [[nodiscard]] std::optional<std::stack<bitree_node*>> pathTo(bitree_node *const node) const noexcept override
+        [[nodiscard]] virtual std::optional<std::stack<bitree_node*>> pathTo(const Tp&) const;
+
+        [[nodiscard]] std::optional<std::stack<bitree_node*>> pathTo(bitree_node *const node) const override
         { return (node == nullptr) ? std::nullopt : pathTo(node->m_value); }
 
+        // Heterogeneous lookups: the key is compared against the stored values as is, without building a Tp
+        template <typename Kp> requires (!std::same_as<Kp, Tp>) && ThreeWayComparator<Compare, Kp, Tp>
+        [[nodiscard]] constexpr const bitree_node* find(const Kp &key) const noexcept
+        { return descend(key, nullptr); }
+
+        template <typename Kp> requires (!std::same_as<Kp, Tp>) && ThreeWayComparator<Compare, Kp, Tp>
+        [[nodiscard]] constexpr const bitree_node* parentOf(const Kp&) const noexcept;
+
+        template <typename Kp> requires ThreeWayComparator<Compare, Kp, Tp>
+        [[nodiscard]] std::optional<std::stack<bitree_node*>> pathTo(const Kp&) const;
+
+
+        //****** Batched Lookups ******//
+        // Writes the node holding each key (or nullptr) to the same position of out; throws if out is shorter than keys
+        void find_batch(std::span<const Tp>, std::span<const bitree_node*>) const;
+
+
+        //****** Range Queries ******//
+        template <typename Kp = Tp> requires ThreeWayComparator<Compare, Kp, Tp>
+        [[nodiscard]] constexpr const bitree_node* lower_bound(const Kp&) const noexcept;
+
+        template <typename Kp = Tp> requires ThreeWayComparator<Compare, Kp, Tp>
+        [[nodiscard]] constexpr const bitree_node* upper_bound(const Kp&) const noexcept;
+
+        template <std::invocable<const Tp&> Fn>
+        constexpr void for_each_in_range(const Tp&, const Tp&, Fn&&) const;
+
 
         //****** Modifiers ******//
         constexpr bool push(const Tp&) override;
+        constexpr bool push(Tp&&) override;
         constexpr bool pop(const Tp &) override;
 
 
+    protected:
+        template <std::random_access_iterator It>
+        void assign_sorted(It, It, bool);
+
+        // Orders key against value: negative if it sorts before, zero if equivalent, positive if after
+        template <typename Kp>
+        [[nodiscard]] static constexpr auto compare(const Kp &key, const Tp &value)
+        { return Compare{}(key, value); }
+
+
     private:
-        constexpr bool remove(bitree_node*, const Tp&);
+        // Lookups advanced together by find_batch; enough to keep the memory system busy without spilling the cursors
+        static constexpr const std::size_t batch_width = 16;
+
+        template <std::random_access_iterator It>
+        bitree_node* build_sorted(It, It, bool) const;
+
+        template <typename Fn>
+        constexpr void visit_range(const bitree_node*, const Tp&, const Tp&, Fn&) const;
+
+        template <typename Vp>
+        constexpr bool insert_leaf(Vp&&);
+
+        template <typename Kp>
+        [[nodiscard]] constexpr bitree_node* descend(const Kp&, bitree_node**) const noexcept;
+
+        constexpr void remove(bitree_node*, bitree_node*);
         using binary_tree<Tp>::is_mirror;
+        using binary_tree<Tp>::last_level_order;    // search trees are not kept complete
+        using binary_tree<Tp>::enable_index;    // ordered lookups are already O(log n) on balanced trees
 
     };  // class binary_search_tree
 
@@ -65,9 +141,9 @@ namespace dsl::nonlinear::tree
     //************ Member Function Implementations ************//
 
 
-    template <Comparable Tp>
-    constexpr const typename binary_search_tree<Tp>::bitree_node&
-    binary_search_tree<Tp>::maxKey(const bitree_node &root) const noexcept
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    constexpr const typename binary_search_tree<Tp, Compare>::bitree_node&
+    binary_search_tree<Tp, Compare>::maxKey(const bitree_node &root) const noexcept
     {
         auto *curr = &root;
         while (curr->m_right != nullptr)
@@ -76,9 +152,9 @@ namespace dsl::nonlinear::tree
     }
 
 
-    template <Comparable Tp>
-    constexpr const typename binary_search_tree<Tp>::bitree_node&
-    binary_search_tree<Tp>::minKey(const bitree_node &root) const noexcept
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    constexpr const typename binary_search_tree<Tp, Compare>::bitree_node&
+    binary_search_tree<Tp, Compare>::minKey(const bitree_node &root) const noexcept
     {
         auto *curr = &root;
         while (curr->m_left != nullptr)
@@ -87,82 +163,231 @@ namespace dsl::nonlinear::tree
     }
 
 
-    template <Comparable Tp>
-    constexpr std::optional<typename binary_search_tree<Tp>::bitree_node&>
-    binary_search_tree<Tp>::parentOf(const Tp &value) const noexcept
+    // Returns the parent of the node holding value, or nullptr if the value is absent or at the root
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    constexpr const typename binary_search_tree<Tp, Compare>::bitree_node*
+    binary_search_tree<Tp, Compare>::parentOf(const Tp &value) const noexcept
     {
-        if (this->m_root == nullptr || this->m_root->m_value == value)
-            return std::nulopt;
+        bitree_node *parent = nullptr;
+        return (descend(value, &parent) == nullptr) ? nullptr : parent;
+    }
 
-        bitree_node *curr = this->m_root, *prev = nullptr;
+
+    // Returns the nodes from the root down to, but excluding, the node holding value
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    std::optional<std::stack<typename binary_search_tree<Tp, Compare>::bitree_node*>>
+    binary_search_tree<Tp, Compare>::pathTo(const Tp &value) const
+    { return pathTo<Tp>(value); }
+
+
+    // Returns the parent of the node holding key, or nullptr if the key is absent or at the root
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    template <typename Kp> requires (!std::same_as<Kp, Tp>) && ThreeWayComparator<Compare, Kp, Tp>
+    constexpr const typename binary_search_tree<Tp, Compare>::bitree_node*
+    binary_search_tree<Tp, Compare>::parentOf(const Kp &key) const noexcept
+    {
+        bitree_node *parent = nullptr;
+        return (descend(key, &parent) == nullptr) ? nullptr : parent;
+    }
+
+
+    // Returns the nodes from the root down to, but excluding, the node holding key
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    template <typename Kp> requires ThreeWayComparator<Compare, Kp, Tp>
+    std::optional<std::stack<typename binary_search_tree<Tp, Compare>::bitree_node*>>
+    binary_search_tree<Tp, Compare>::pathTo(const Kp &key) const
+    {
+        auto s { std::stack<bitree_node*>{} };
+
+        auto *curr = this->m_root;
         while (curr != nullptr)
         {
-            if (curr->m_value == value)
-                return prev;
-            prev = curr;
-            curr = (value < curr->m_value) ? curr->m_left : curr->m_right;
+            const auto order = compare(key, curr->m_value);
+            if (order == 0)
+                break;
+            s.push(curr);
+            curr = (order < 0) ? curr->m_left : curr->m_right;
         }
-        return std::nullopt;
+
+        if (curr == nullptr)
+            return std::nullopt;
+        return s;
     }
 
 
-    template <Comparable Tp>
-    constexpr std::optional<const typename binary_search_tree<Tp>::bitree_node&>
-    binary_search_tree<Tp>::find(const Tp &value) const noexcept
+    // Runs the lookups in groups, moving each one level down per round and prefetching the node it lands on,
+    // so a group waits on its cache misses together rather than on one level of one lookup at a time
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    void binary_search_tree<Tp, Compare>::find_batch(const std::span<const Tp> keys,
+                                                     const std::span<const bitree_node*> out) const
     {
-        if (this->m_root == nullptr)
-            return std::nullopt;
+        if (out.size() < keys.size())
+            throw std::invalid_argument("Cannot write the results of a batch to a shorter span.");
 
-        auto *curr = this->m_root;
-        while (curr != nullptr)
+        const bitree_node *cursors[batch_width];
+        for (std::size_t first = 0; first < keys.size(); first += batch_width)
         {
-            if (curr->m_value == value)
-                return *curr;
-            curr = (value < curr->m_value) ? curr->m_left : curr->m_right;
+            const auto width = std::min(batch_width, keys.size() - first);
+            std::fill_n(cursors, width, this->m_root);
+            std::fill_n(out.begin() + first, width, nullptr);
+
+            auto active = width;
+
+            while (active > 0)
+            {
+                active = 0;
+                for (std::size_t i = 0; i < width; i++)
+                {
+                    const auto *curr = cursors[i];
+                    if (curr == nullptr)
+                        continue;
+
+                    const auto order = compare(keys[first + i], curr->m_value);
+                    if (order == 0)
+                    {
+                        out[first + i] = curr;
+                        curr = nullptr;
+                    }
+                    else
+                        curr = (order < 0) ? curr->m_left : curr->m_right;
+
+                    cursors[i] = curr;
+                    if (curr != nullptr)
+                    {
+                        DS_GRAPH_PREFETCH(curr);
+                        active++;
+                    }
+                }
+            }
         }
-        return std::nullopt;
     }
 
 
-    template <Comparable Tp>
-    std::optional<std::stack<typename binary_search_tree<Tp>::bitree_node*>>
-    binary_search_tree<Tp>::pathTo(const Tp &value) const noexcept
+    // Returns the node with the smallest key not less than value, or nullptr if there is none
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    template <typename Kp> requires ThreeWayComparator<Compare, Kp, Tp>
+    constexpr const typename binary_search_tree<Tp, Compare>::bitree_node*
+    binary_search_tree<Tp, Compare>::lower_bound(const Kp &value) const noexcept
     {
-        auto s = { std::stack<bitree_node*>{} };
+        const bitree_node *curr = this->m_root, *bound = nullptr;
+        while (curr != nullptr)
+        {
+            if (compare(value, curr->m_value) > 0)
+                curr = curr->m_right;
+            else
+            {
+                bound = curr;
+                curr = curr->m_left;
+            }
+        }
+        return bound;
+    }
 
-        auto *curr = this->m_root;
+
+    // Returns the node with the smallest key greater than value, or nullptr if there is none
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    template <typename Kp> requires ThreeWayComparator<Compare, Kp, Tp>
+    constexpr const typename binary_search_tree<Tp, Compare>::bitree_node*
+    binary_search_tree<Tp, Compare>::upper_bound(const Kp &value) const noexcept
+    {
+        const bitree_node *curr = this->m_root, *bound = nullptr;
         while (curr != nullptr)
         {
-            if (curr->m_value == value)
-                break;
-            s.push(curr);
-            curr = (value < curr->m_value) ? curr->m_left : curr->m_right;
+            if (compare(value, curr->m_value) < 0)
+            {
+                bound = curr;
+                curr = curr->m_left;
+            }
+            else
+                curr = curr->m_right;
         }
+        return bound;
+    }
+
+
+    // Calls fn, in ascending order, on every key in the closed range [lo, hi] without allocating
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    template <std::invocable<const Tp&> Fn>
+    constexpr void binary_search_tree<Tp, Compare>::for_each_in_range(const Tp &lo, const Tp &hi, Fn &&fn) const
+    {
+        if (!(compare(hi, lo) < 0))
+            visit_range(this->m_root, lo, hi, fn);
+    }
+
+
+    // for_each_in_range helper function; in-order traversal with an explicit stack that skips subtrees below lo
+    // and stops at the first key above hi
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    template <typename Fn>
+    constexpr void binary_search_tree<Tp, Compare>::visit_range(const bitree_node *const root, const Tp &lo, const Tp &hi, Fn &fn) const
+    {
+        auto s { details::node_stack<const bitree_node*>{} };
+        auto *curr = root;
+
+        while (curr != nullptr || !s.empty())
+        {
+            while (curr != nullptr)
+            {
+                // A key below lo rules out its whole left subtree
+                if (compare(lo, curr->m_value) > 0)
+                    curr = curr->m_right;
+                else
+                {
+                    s.push(curr);
+                    curr = curr->m_left;
+                }
+            }
 
-        return (curr == nullptr) ? std::nullopt : s;
+            if (s.empty())
+                return;
+
+            curr = s.top();
+            s.pop();
+            if (compare(hi, curr->m_value) < 0)
+                return;
+
+            fn(curr->m_value);
+            curr = curr->m_right;
+        }
     }
 
 
-    template <Comparable Tp>
-    constexpr bool binary_search_tree<Tp>::push(const Tp &value)
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    constexpr bool binary_search_tree<Tp, Compare>::push(const Tp &value)
+    { return insert_leaf(value); }
+
+
+    // As push, moving the value into the new node (only if it is inserted)
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    constexpr bool binary_search_tree<Tp, Compare>::push(Tp &&value)
+    { return insert_leaf(std::move(value)); }
+
+
+    // push helper function; forwards the value into a new leaf once its position is known
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    template <typename Vp>
+    constexpr bool binary_search_tree<Tp, Compare>::insert_leaf(Vp &&value)
     {
         if (this->m_root == nullptr)
-            this->m_root = new bitree_node<Tp>(value);
+            this->m_root = this->make_node(std::forward<Vp>(value));
         else
         {
             bitree_node *curr = this->m_root, *prev = nullptr;
+            auto left = false;
             while (curr != nullptr)
             {
-                if (curr->m_value == value)
+                const auto order = compare(value, curr->m_value);
+                if (order == 0)
                     return false;
                 prev = curr;
-                curr = (value < curr->m_value) ? curr->m_left : curr->m_right;
+                left = order < 0;
+                curr = (left) ? curr->m_left : curr->m_right;
             }
 
-            if (value < prev->m_value)
-                prev->m_left = new bitree_node<Tp>(value);
+            if (left)
+                prev->m_left = this->make_node(std::forward<Vp>(value));
             else
-                prev->m_right = new bitree_node<Tp>(value);
+                prev->m_right = this->make_node(std::forward<Vp>(value));
 
         }
         this->m_size++;
@@ -170,44 +395,106 @@ namespace dsl::nonlinear::tree
     }
 
 
-    // remove helper function
-    template <Comparable Tp>
-    constexpr bool binary_search_tree<Tp>::remove(bitree_node *const root, const Tp &value)
+    // Replaces the (empty) tree with a perfectly balanced tree holding the sorted range [first, last)
+    // A slab serves one thread at a time, so a tree with one builds on the calling thread
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    template <std::random_access_iterator It>
+    void binary_search_tree<Tp, Compare>::assign_sorted(It first, It last, const bool parallel)
     {
-        if (root == nullptr)
-            return false;
+        this->m_root = build_sorted(first, last, parallel && !this->slab_enabled());
+        this->m_size = static_cast<int>(std::distance(first, last));
+    }
 
-        if (value < root->m_value)
-            return remove(root->m_left, value);
-        else if (value > root->m_value)
-            return remove(root->m_right, value);
-        else
+
+    // assign_sorted helper function; the middle key of each range becomes the subtree root
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    template <std::random_access_iterator It>
+    typename binary_search_tree<Tp, Compare>::bitree_node*
+    binary_search_tree<Tp, Compare>::build_sorted(It first, It last, const bool parallel) const
+    {
+        if (first == last)
+            return nullptr;
+
+        auto mid = first + std::distance(first, last) / 2;
+        auto *root = this->make_node(*mid);
+
+        // Ranges within the cutoff are built on the calling thread
+        const auto estimate = parallel ? static_cast<int>(std::distance(first, last)) : 0;
+        this->fork(estimate,
+                   [&] { root->m_left = build_sorted(first, mid, parallel); },
+                   [&] { root->m_right = build_sorted(mid + 1, last, parallel); });
+
+        this->refresh(root);
+        return root;
+    }
+
+
+    // Walks down to the node holding key, recording its parent if asked; returns nullptr if the key is absent
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    template <typename Kp>
+    constexpr typename binary_search_tree<Tp, Compare>::bitree_node*
+    binary_search_tree<Tp, Compare>::descend(const Kp &key, bitree_node **const parent) const noexcept
+    {
+        bitree_node *curr = this->m_root, *prev = nullptr;
+        while (curr != nullptr)
         {
-            if (root->m_left == nullptr && root->m_right == nullptr)
-            {
-                delete root;
-                root = nullptr;
-            }
-            else if (root->m_left != nullptr && root->m_right != nullptr)
-            {
-                auto iop = maxKey(*(root->m_left));
-                root->m_value(iop.m_value);
-                return remove(node->m_left, iop.m_value);
-            }
-            else
+            const auto order = compare(key, curr->m_value);
+            if (order == 0)
+                break;
+            prev = curr;
+            curr = (order < 0) ? curr->m_left : curr->m_right;
+        }
+
+        if (parent != nullptr)
+            *parent = prev;
+        return curr;
+    }
+
+
+    // pop helper function; unlinks and deletes a node, given its parent (nullptr for the root)
+    // A node with two children takes its in-order predecessor's value, and the predecessor is unlinked instead
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    constexpr void binary_search_tree<Tp, Compare>::remove(bitree_node *node, bitree_node *parent)
+    {
+        if (node->m_left != nullptr && node->m_right != nullptr)
+        {
+            auto *pred = node->m_left;
+            parent = node;
+            while (pred->m_right != nullptr)
             {
-                auto *child = (root->m_left != nullptr)
-                        ? root->m_left : root->m_right;
-                root = child;
+                parent = pred;
+                pred = pred->m_right;
             }
 
-            return true;
+            node->m_value = std::move(pred->m_value);
+            node = pred;
         }
+
+        auto *child = (node->m_left != nullptr) ? node->m_left : node->m_right;
+        if (parent == nullptr)
+            this->m_root = child;
+        else if (parent->m_left == node)
+            parent->m_left = child;
+        else
+            parent->m_right = child;
+
+        delete node;
+        this->m_size--;
     }
 
-    template <Comparable Tp>
-    [[nodiscard]] constexpr bool binary_search_tree<Tp>::pop(const Tp &value)
-    { return (!find(value)) false : remove(this->m_root, value); }
+
+    // Removes the node holding value, if there is one
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    constexpr bool binary_search_tree<Tp, Compare>::pop(const Tp &value)
+    {
+        bitree_node *parent = nullptr;
+        auto *node = descend(value, &parent);
+        if (node == nullptr)
+            return false;
+
+        remove(node, parent);
+        return true;
+    }
 
 }   // namespace nonlinear::tree
 
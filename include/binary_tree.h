@@ -2,13 +2,26 @@
 #define DS_GRAPH_BINARY_TREE_H
 
 
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdlib>
+#include <functional>
 #include <limits>
+#include <new>
+#include <optional>
 #include <ostream>
 #include <queue>
 #include <stack>
 #include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "bitree_node.h"
+#include "fork_join.h"
+#include "node_arena.h"
 #include "traits.h"
 
 
@@ -16,38 +29,101 @@ namespace dsl::nonlinear::tree
 {
     namespace details
     {
+        // Lookup index for unordered trees; without a hash for Tp it is never constructed and every hook is a no-op
         template <Comparable Tp>
-        struct bitree_node
+        struct bitree_index
         {
-            // No-throw constructors
-            constexpr bitree_node() noexcept = default;
-            constexpr explicit bitree_node(const Tp &value) noexcept
-                : m_value(value),
-                  m_left(nullptr),
-                  m_right(nullptr) {}
-
-            // No-throw copy assignment
-            constexpr bitree_node& operator=(const bitree_node &rhs) noexcept
+            constexpr void linked(bitree_node<Tp>*, bitree_node<Tp>*) noexcept {}
+            constexpr void unlinked(const bitree_node<Tp>*) noexcept {}
+            constexpr void revalued(bitree_node<Tp>*, const Tp&) noexcept {}
+
+            [[nodiscard]] constexpr bitree_node<Tp>* find(const Tp&) const noexcept                   { return nullptr; }
+            [[nodiscard]] constexpr bitree_node<Tp>* parent(const bitree_node<Tp>*) const noexcept    { return nullptr; }
+
+        };  // struct bitree_index
+
+
+        template <Comparable Tp> requires Hashable<Tp>
+        struct bitree_index<Tp>
+        {
+            // Records a node newly linked under parent (nullptr for the root)
+            void linked(bitree_node<Tp> *const node, bitree_node<Tp> *const parent)
             {
-                if (this == &rhs) return *this;
-                m_value = rhs.m_value;
-                m_left = rhs.m_left;
-                m_right = rhs.m_right;
-                return *this;
+                m_nodes.emplace(node->m_value, node);
+                if (parent != nullptr)
+                    m_parents.emplace(node, parent);
             }
 
-            // Delegate resource destruction responsibility to the containing class
-            virtual ~bitree_node() noexcept = default;
+            // Forgets a node about to be unlinked and deleted
+            void unlinked(const bitree_node<Tp> *const node) noexcept
+            {
+                erase_value(node->m_value, node);
+                m_parents.erase(node);
+            }
 
-            Tp m_value;
-            bitree_node *m_left, *m_right;
+            // Re-keys a node whose value changed from old_value
+            void revalued(bitree_node<Tp> *const node, const Tp &old_value)
+            {
+                erase_value(old_value, node);
+                m_nodes.emplace(node->m_value, node);
+            }
 
-        };  // struct bitree_node
+            // Any one of the nodes holding the value; duplicates are not kept in level order
+            [[nodiscard]] bitree_node<Tp>* find(const Tp &value) const noexcept
+            {
+                auto it = m_nodes.find(value);
+                return (it == m_nodes.end()) ? nullptr : it->second;
+            }
+
+            [[nodiscard]] bitree_node<Tp>* parent(const bitree_node<Tp> *const node) const noexcept
+            {
+                auto it = m_parents.find(node);
+                return (it == m_parents.end()) ? nullptr : it->second;
+            }
+
+        private:
+            void erase_value(const Tp &value, const bitree_node<Tp> *const node) noexcept
+            {
+                auto [first, last] = m_nodes.equal_range(value);
+                for (; first != last; ++first)
+                {
+                    if (first->second == node)
+                    {
+                        m_nodes.erase(first);
+                        return;
+                    }
+                }
+            }
+
+            std::unordered_multimap<Tp, bitree_node<Tp>*> m_nodes;     // duplicate values are allowed
+            std::unordered_map<const bitree_node<Tp>*, bitree_node<Tp>*> m_parents;
+
+        };  // struct bitree_index
 
     }   // namespace details
 
 
 
+    template <Comparable Tp>
+    constexpr bool bitree_same(const details::bitree_node<Tp>*, const details::bitree_node<Tp>*);
+
+
+
+    // Shape properties of a subtree, all gathered by binary_tree::stats in a single bottom-up pass
+    struct tree_stats
+    {
+        int m_height = 0;           // levels; an empty tree has height 0
+        int m_size = 0;
+        int m_leaves = 0;
+        bool m_balanced = true;     // every node's subtrees differ in height by at most 1
+        bool m_complete = true;     // every level full except the last, which is filled from the left
+        bool m_perfect = true;      // every level full
+        bool m_full = true;         // every node has zero or two children
+
+    };  // struct tree_stats
+
+
+
     template <Comparable Tp>
     class binary_tree
     {
@@ -60,12 +136,28 @@ namespace dsl::nonlinear::tree
         // No-throw constructor
         binary_tree() noexcept
             : m_root(nullptr),
-              m_size(0) {}
-
-        // Copy constructor
+              m_size(0),
+              m_index(nullptr),
+              m_cutoff(default_parallel_cutoff),
+              m_slab(nullptr),
+              m_slab_sole(false) {}
+
+        // Copy constructor; the copy is not indexed, and all its nodes share one arena allocation,
+        // which becomes the copy's slab if rhs has one
         binary_tree(const binary_tree &rhs)
-            : m_root(rhs.m_root == nullptr ? nullptr : copy()),
-              m_size(rhs.m_size) {}
+            : m_root(nullptr),
+              m_size(rhs.m_size),
+              m_index(nullptr),
+              m_cutoff(rhs.m_cutoff),
+              m_slab(nullptr),
+              m_slab_sole(false)
+        {
+            if (rhs.m_slab != nullptr)
+                enable_slab();
+
+            try { m_root = copy(rhs.m_root, rhs.m_size); }
+            catch (...) { disable_slab(); throw; }
+        }
 
         // Move constructor
         binary_tree(binary_tree &&rhs) noexcept
@@ -85,15 +177,15 @@ namespace dsl::nonlinear::tree
         [[nodiscard]] constexpr bitree_node* root() const noexcept    { return m_root; }
         [[nodiscard]] constexpr int size() const noexcept             { return m_size; }
 
-        [[nodiscard]] constexpr int depth(bitree_node *const root) const noexcept
-        { return (root == nullptr) ? 0 : std::max(depth(root->m_left) + 1, depth(root->m_right) + 1); }
+        [[nodiscard]] constexpr int depth(bitree_node*) const;
 
-        constexpr void in_order(bitree_node*, std::ostream&) const noexcept;
-        constexpr void post_order(bitree_node*, std::ostream&) const noexcept;
-        constexpr void pre_order(bitree_node*, std::ostream&) const noexcept;
+        constexpr void in_order(bitree_node*, std::ostream&) const;
+        constexpr void post_order(bitree_node*, std::ostream&) const;
+        constexpr void pre_order(bitree_node*, std::ostream&) const;
         [[nodiscard]] constexpr bitree_node* last_level_order() const;
 
-        friend std::ostream& operator<<(std::ostream&, const binary_tree<Tp>&) noexcept;
+        template <Comparable Up>
+        friend std::ostream& operator<<(std::ostream&, const binary_tree<Up>&);
 
         [[nodiscard]] virtual constexpr const bitree_node& maxKey(const bitree_node&) const noexcept;
         [[nodiscard]] virtual constexpr const bitree_node& minKey(const bitree_node&) const noexcept;
@@ -103,37 +195,126 @@ namespace dsl::nonlinear::tree
         [[nodiscard]] virtual constexpr const Tp& max() const;
         [[nodiscard]] virtual constexpr const Tp& min() const;    // throws if root is nullptr
 
-        virtual constexpr std::optional<bitree_node&> parentOf(const bitree_node&) const noexcept;
-        virtual constexpr std::optional<bitree_node&> parentOf(const Tp&) const noexcept;
-        virtual constexpr std::optional<bitree_node&> find(const Tp&) const noexcept;
+        // Lookups return nullptr when there is no such node
+        [[nodiscard]] virtual constexpr const bitree_node* parentOf(const bitree_node&) const;
+        [[nodiscard]] virtual constexpr const bitree_node* parentOf(const Tp&) const;
+        [[nodiscard]] virtual constexpr const bitree_node* find(const Tp&) const;
 
-        virtual std::optional<std::stack<bitree_node*>> pathTo(bitree_node*) const noexcept;
+        [[nodiscard]] virtual std::optional<std::stack<bitree_node*>> pathTo(bitree_node*) const;
         [[nodiscard]] virtual std::vector<bitree_node*> toVector(const bitree_node&) const noexcept;
 
 
         //****** Properties ******//
-        [[nodiscard]] constexpr bool is_complete(bitree_node *const node) const noexcept  { return complete(node, 0); }
-        [[nodiscard]] constexpr bool is_perfect(bitree_node *const node) const noexcept   { return perfect(node, 0); }
-        [[nodiscard]] constexpr bool is_balanced(bitree_node*) const noexcept;
-        [[nodiscard]] constexpr bool is_full(bitree_node*) const noexcept;
+        [[nodiscard]] tree_stats stats(bitree_node*, bool = false) const;
+
+        [[nodiscard]] bool is_complete(bitree_node *const node) const  { return stats(node).m_complete; }
+        [[nodiscard]] bool is_perfect(bitree_node *const node) const   { return stats(node).m_perfect; }
+        [[nodiscard]] bool is_balanced(bitree_node *const node) const  { return stats(node).m_balanced; }
+        [[nodiscard]] bool is_full(bitree_node *const node) const      { return stats(node).m_full; }
         [[nodiscard]] constexpr bool is_mirror(bitree_node*, bitree_node*) const noexcept;
 
 
         //****** Modifiers ******//
         virtual constexpr bool push(const Tp&);
+        virtual constexpr bool push(Tp&&);
         virtual constexpr bool pop(const Tp&);
+        void clear(bool = false) noexcept;
+
+        // Builds the value from args once and moves it into its node, through the most derived push
+        template <typename... Args> requires std::constructible_from<Tp, Args...>
+        bool emplace(Args &&...args)
+        { return push(Tp(std::forward<Args>(args)...)); }
+
+
+        //****** Parallel Execution ******//
+        // With parallel = true, whole-tree operations fork subtrees onto the shared work-stealing pool
+        // Subtrees estimated to hold no more than parallel_cutoff() nodes run sequentially; the destructor
+        // never starts the pool, so call clear(true) first to tear a large tree down in parallel
+        [[nodiscard]] constexpr int parallel_cutoff() const noexcept      { return m_cutoff; }
+        constexpr void parallel_cutoff(const int cutoff) noexcept         { m_cutoff = std::max(1, cutoff); }
+
+        // Folds map(node) over a subtree with op, which must be associative and commutative (and thread-safe)
+        template <typename Rp, std::invocable<const bitree_node&> Map, std::invocable<Rp, Rp> Op>
+        [[nodiscard]] Rp reduce(const bitree_node*, Rp, Map, Op, bool = false) const;
+
+        [[nodiscard]] bool equals(const binary_tree&, bool = false) const;
+
+
+        //****** Indexing ******//
+        // Hash maps from value to node and node to parent, kept by push and pop, make find and parentOf O(1) expected
+        void enable_index() requires Hashable<Tp>;
+        void disable_index() noexcept;
+        [[nodiscard]] constexpr bool indexed() const noexcept     { return m_index != nullptr; }
+
+
+        //****** Allocation ******//
+        // With a slab, new nodes are carved from a chain of large blocks rather than allocated one by one. While every
+        // node lives in the tree's own slab and Tp is trivially destructible, clear and the destructor free the blocks
+        // without visiting the nodes. Like push, slab allocation must not run on two threads at once
+        void enable_slab();
+        void disable_slab() noexcept;
+        [[nodiscard]] constexpr bool slab_enabled() const noexcept    { return m_slab != nullptr; }
 
 
     protected:
+        using bitree_index = typename details::bitree_index<Tp>;
+
         bitree_node *m_root;    // prefer smart ptr; this impl uses owning raw ptr
         int m_size;
+        bitree_index *m_index;  // nullptr unless enable_index has been called
+        int m_cutoff;           // parallel operations run subtrees estimated at or below this size sequentially
+        node_slab *m_slab;      // nullptr unless enable_slab has been called
+        mutable bool m_slab_sole;   // true while every node lives in m_slab and no other tree holds nodes from it
+
+        // Node factory; trees whose nodes carry extra (augmented) data override it to allocate richer nodes
+        [[nodiscard]] virtual bitree_node* make_node(const Tp &value) const
+        { return create_node<bitree_node>(value); }
+
+        [[nodiscard]] virtual bitree_node* make_node(Tp &&value) const
+        { return create_node<bitree_node>(std::move(value)); }
+
+        // Constructs a node of the given type in the slab, if there is one and it has room, otherwise with new
+        template <typename Node, typename... Args>
+        [[nodiscard]] bitree_node* create_node(Args&&...) const;
+
+        // To be called before nodes move between trees: if rhs is consumed into this tree, its slab is taken over
+        // when both trees own theirs outright; otherwise neither tree may free its slab in bulk from then on
+        void share_slab(binary_tree&, bool) noexcept;
+
+        // Recomputes a node's augmented data from its children; called bottom-up whenever links change
+        virtual constexpr void refresh(bitree_node*) const noexcept {}
+
+        static void destroy(bitree_node*) noexcept;
+
+        // Runs both callables, concurrently on the shared pool when the estimated work exceeds the cutoff
+        template <std::invocable F, std::invocable G>
+        void fork(int, F&&, G&&) const;
+
+        constexpr bitree_node* level_order_at(unsigned, bitree_node*&) const noexcept;
+        [[nodiscard]] constexpr bitree_node* find_node(const Tp&) const;
+        [[nodiscard]] constexpr bitree_node* parent_node(const bitree_node*) const;
+        constexpr void assign_value(bitree_node*, const Tp&);
+        constexpr void swap_values(bitree_node*, bitree_node*);
+        constexpr bitree_node* erase_node(bitree_node*);
+        constexpr bool push_node(bitree_node*);
 
 
     private:
-        constexpr bitree_node* copy(bitree_node*);
-        constexpr bool complete(bitree_node*, int) const noexcept;
-        constexpr bool perfect(bitree_node*, int, int=0) const noexcept;
-        constexpr bool hasPath(bitree_node*, const bitree_node&, std::stack<bitree_node*>&) const noexcept;
+        [[nodiscard]] bitree_node* copy(const bitree_node*, int);
+        [[nodiscard]] static bitree_node* copy_subtree(const bitree_node*, node_arena*);
+        [[nodiscard]] static bitree_node* clone_node(const bitree_node*, node_arena*);
+        void parallel_destroy(bitree_node*, int) const noexcept;
+        [[nodiscard]] bool parallel_same(const bitree_node*, const bitree_node*, int) const;
+
+        template <typename Rp, typename Map, typename Op>
+        [[nodiscard]] static Rp sequential_reduce(const bitree_node*, Rp, Map&, Op&);
+        template <typename Rp, typename Map, typename Op>
+        [[nodiscard]] Rp parallel_reduce(const bitree_node*, const Rp&, Map&, Op&, int) const;
+
+        [[nodiscard]] static constexpr tree_stats combine(const bitree_node*, const tree_stats&, const tree_stats&) noexcept;
+        [[nodiscard]] tree_stats sequential_stats(bitree_node*) const;
+        [[nodiscard]] tree_stats parallel_stats(bitree_node*, int) const;
+        constexpr bool hasPath(bitree_node*, const bitree_node&, std::stack<bitree_node*>&) const;
         constexpr void vectorize(bitree_node*, std::vector<bitree_node*>&) const noexcept;
 
     };  // class binary_tree
@@ -143,43 +324,176 @@ namespace dsl::nonlinear::tree
     //************ Member Function Implementations ************//
 
 
-    // Copy constructor helper function
+    // Copy constructor helper function; sizes one arena for all count nodes, then clones into it in a single pass
     template <Comparable Tp>
-    constexpr typename binary_tree<Tp>::bitree_node*
-    binary_tree<Tp>::copy(typename binary_tree<Tp>::bitree_node *const root)
+    typename binary_tree<Tp>::bitree_node*
+    binary_tree<Tp>::copy(const typename binary_tree<Tp>::bitree_node *const root, const int count)
     {
         if (root == nullptr) return nullptr;
-        root->m_left = copy(root->m_left);
-        root->m_right = copy(root->m_right);
-        return root;
+
+        // Nodes too large for an arena chunk are allocated one by one
+        auto *arena = node_arena::create(static_cast<std::size_t>(std::max(count, 1)), root->footprint());
+        bitree_node *result = nullptr;
+        try { result = copy_subtree(root, arena); }
+        catch (...)
+        {
+            if (arena != nullptr) arena->seal();
+            throw;
+        }
+
+        if (arena == nullptr)
+            m_slab_sole = false;
+        else if (m_slab != nullptr)
+            m_slab->adopt(arena);
+        else
+            arena->seal();
+        return result;
     }
 
 
-    // Virtual destructor
+    // Clones a subtree with an explicit stack of (source, copy) pairs; siblings land in adjacent slots and
+    // each left subtree is laid out before its right sibling's subtree
     template <Comparable Tp>
-    binary_tree<Tp>::~binary_tree()
+    typename binary_tree<Tp>::bitree_node*
+    binary_tree<Tp>::copy_subtree(const typename binary_tree<Tp>::bitree_node *const root, node_arena *const arena)
     {
-        if (m_root != nullptr)
+        auto *result = clone_node(root, arena);
+        try
         {
-            auto q { std::queue<bitree_node*>{} };
-            q.push(m_root);
-            while (!q.empty())
+            auto s { details::node_stack<std::pair<const bitree_node*, bitree_node*>>{} };
+            s.push({root, result});
+            while (!s.empty())
             {
-                auto *curr = q.front();
-                q.pop();
+                auto [src, dst] = s.top();
+                s.pop();
+
+                if (src->m_right != nullptr)
+                {
+                    dst->m_right = clone_node(src->m_right, arena);
+                    s.push({src->m_right, dst->m_right});
+                }
+                if (src->m_left != nullptr)
+                {
+                    dst->m_left = clone_node(src->m_left, arena);
+                    s.push({src->m_left, dst->m_left});
+                }
+            }
+        }
+        catch (...)
+        {
+            destroy(result);
+            throw;
+        }
+        return result;
+    }
+
+
+    // Clones one node into the next arena slot, or into its own allocation once the arena is exhausted
+    template <Comparable Tp>
+    typename binary_tree<Tp>::bitree_node*
+    binary_tree<Tp>::clone_node(const typename binary_tree<Tp>::bitree_node *const node, node_arena *const arena)
+    {
+        auto *slot = (arena != nullptr) ? arena->allocate() : nullptr;
+        if (slot == nullptr)
+            return node->clone();
+
+        try { return node->clone_into(slot); }
+        catch (...)
+        {
+            node_arena::release(slot);
+            throw;
+        }
+    }
+
+
+    // Virtual destructor
+    template <Comparable Tp>
+    binary_tree<Tp>::~binary_tree()
+    {
+        clear();
+        disable_index();
+        disable_slab();
+    }
 
-                if (curr->m_left != nullptr)
-                    q.push(curr->m_left);
-                if (curr->m_right != nullptr)
-                    q.push(curr->m_right);
 
+    // Deletes every node of the subtree rooted at the given node without allocating: left children are
+    // rotated up until the current node has none, so it can be freed and the walk continued to its right
+    template <Comparable Tp>
+    void binary_tree<Tp>::destroy(typename binary_tree<Tp>::bitree_node *const root) noexcept
+    {
+        auto *curr = root;
+        while (curr != nullptr)
+        {
+            if (curr->m_left != nullptr)
+            {
+                auto *left = curr->m_left;
+                curr->m_left = left->m_right;
+                left->m_right = curr;
+                curr = left;
+            }
+            else
+            {
+                auto *right = curr->m_right;
                 delete curr;
-                curr = nullptr;
+                curr = right;
             }
         }
     }
 
 
+    // Deletes the subtree, freeing its two halves concurrently while it is larger than the cutoff
+    // If the pool cannot take the fork, the halves it did not get to are freed sequentially instead
+    template <Comparable Tp>
+    void binary_tree<Tp>::parallel_destroy(typename binary_tree<Tp>::bitree_node *const root, const int estimate) const noexcept
+    {
+        if (root == nullptr || estimate <= m_cutoff)
+        {
+            destroy(root);
+            return;
+        }
+
+        auto *left = root->m_left, *right = root->m_right;
+        delete root;
+        try
+        {
+            fork(estimate,
+                 [&] { parallel_destroy(left, estimate / 2); left = nullptr; },
+                 [&] { parallel_destroy(right, estimate / 2); right = nullptr; });
+        }
+        catch (...)
+        {
+            destroy(left);
+            destroy(right);
+        }
+    }
+
+
+    // Deletes every node, leaving an empty tree (still indexed, if it was)
+    template <Comparable Tp>
+    void binary_tree<Tp>::clear(const bool parallel) noexcept
+    {
+        // Nodes that are all in the slab with nothing to destroy go with their blocks
+        if (m_slab != nullptr && m_slab_sole && std::is_trivially_destructible_v<Tp>)
+            m_slab->free_all();
+        else if (!parallel)
+            destroy(m_root);
+        else
+            parallel_destroy(m_root, m_size);
+
+        // Blocks whose slots were all released are freed; the tree starts over on fresh ones
+        if (m_slab != nullptr)
+        {
+            m_slab->reset();
+            m_slab_sole = true;
+        }
+
+        m_root = nullptr;
+        m_size = 0;
+        if (m_index != nullptr)
+            *m_index = bitree_index{};
+    }
+
+
     // Member swap function
     template <Comparable Tp>
     constexpr void binary_tree<Tp>::swap(binary_tree<Tp> &rhs) noexcept
@@ -187,43 +501,128 @@ namespace dsl::nonlinear::tree
         using std::swap;
         swap(rhs.m_root, m_root);
         swap(rhs.m_size, m_size);
+        swap(rhs.m_index, m_index);
+        swap(rhs.m_cutoff, m_cutoff);
+        swap(rhs.m_slab, m_slab);
+        swap(rhs.m_slab_sole, m_slab_sole);
+    }
+
+
+    // Runs both callables, forking the second onto the shared pool only when the work is large enough to pay off
+    template <Comparable Tp>
+    template <std::invocable F, std::invocable G>
+    void binary_tree<Tp>::fork(const int estimate, F &&f, G &&g) const
+    {
+        if (estimate > m_cutoff)
+            fork_join_pool::shared().invoke(std::forward<F>(f), std::forward<G>(g));
+        else
+        {
+            std::invoke(f);
+            std::invoke(g);
+        }
+    }
+
+
+    // Returns the number of levels in the subtree rooted at the given node
+    template <Comparable Tp>
+    constexpr int binary_tree<Tp>::depth(typename binary_tree<Tp>::bitree_node *const root) const
+    {
+        auto result = 0;
+        auto s { details::node_stack<std::pair<bitree_node*, int>>{} };
+        if (root != nullptr)
+            s.push({root, 1});
+
+        while (!s.empty())
+        {
+            auto [curr, level] = s.top();
+            s.pop();
+
+            result = std::max(result, level);
+            if (curr->m_right != nullptr)
+                s.push({curr->m_right, level + 1});
+            if (curr->m_left != nullptr)
+                s.push({curr->m_left, level + 1});
+        }
+        return result;
     }
 
 
     // Writes the tree to an output stream via in-order traversal
     template <Comparable Tp>
-    constexpr void binary_tree<Tp>::in_order(typename binary_tree<Tp>::bitree_node *const node, std::ostream &os) const noexcept
+    constexpr void binary_tree<Tp>::in_order(typename binary_tree<Tp>::bitree_node *const node, std::ostream &os) const
     {
-        if (node == nullptr) return;
-        in_order(node->m_left);
-        os << node->m_value;
-        in_order(node->m_right);
+        auto s { details::node_stack<bitree_node*>{} };
+        auto *curr = node;
+
+        while (curr != nullptr || !s.empty())
+        {
+            if (curr != nullptr)
+            {
+                s.push(curr);
+                curr = curr->m_left;
+                continue;
+            }
+
+            curr = s.top();
+            s.pop();
+            os << curr->m_value;
+            curr = curr->m_right;
+        }
     }
 
 
     // Writes the tree to an output stream via post-order traversal
     template <Comparable Tp>
-    constexpr void binary_tree<Tp>::post_order(typename binary_tree<Tp>::bitree_node *const node, std::ostream &os) const noexcept
+    constexpr void binary_tree<Tp>::post_order(typename binary_tree<Tp>::bitree_node *const node, std::ostream &os) const
     {
-        if (node == nullptr) return;
-        post_order(node->m_left);
-        post_order(node->m_right);
-        os << node->m_value;
+        auto s { details::node_stack<bitree_node*>{} };
+        bitree_node *curr = node, *last = nullptr;
+
+        while (curr != nullptr || !s.empty())
+        {
+            if (curr != nullptr)
+            {
+                s.push(curr);
+                curr = curr->m_left;
+                continue;
+            }
+
+            auto *top = s.top();
+            if (top->m_right != nullptr && top->m_right != last)
+                curr = top->m_right;
+            else
+            {
+                os << top->m_value;
+                last = top;
+                s.pop();
+            }
+        }
     }
 
 
     // Writes the tree to an output stream via pre-order traversal
     template <Comparable Tp>
-    constexpr void binary_tree<Tp>::pre_order(typename binary_tree<Tp>::bitree_node *const node, std::ostream &os) const noexcept
+    constexpr void binary_tree<Tp>::pre_order(typename binary_tree<Tp>::bitree_node *const node, std::ostream &os) const
     {
-        if (node == nullptr) return;
-        os << node->m_value;
-        pre_order(node->m_left);
-        pre_order(node->m_right);
+        auto s { details::node_stack<bitree_node*>{} };
+        if (node != nullptr)
+            s.push(node);
+
+        while (!s.empty())
+        {
+            auto *curr = s.top();
+            s.pop();
+
+            os << curr->m_value;
+            if (curr->m_right != nullptr)
+                s.push(curr->m_right);
+            if (curr->m_left != nullptr)
+                s.push(curr->m_left);
+        }
     }
 
 
-    // Finds the deepest, rightmost node in the tree
+    // Finds the deepest, rightmost node in the tree in O(log n); push and pop keep the tree complete
     template <Comparable Tp>
     constexpr typename binary_tree<Tp>::bitree_node*
     binary_tree<Tp>::last_level_order() const
@@ -231,25 +630,36 @@ namespace dsl::nonlinear::tree
         if (m_root == nullptr)
             throw std::out_of_range("Cannot find last node in level order in empty tree.");
 
-        bitree_node *curr = m_root, *prev = nullptr;
-        while (curr != nullptr)
+        bitree_node *parent = nullptr;
+        return level_order_at(static_cast<unsigned>(m_size), parent);
+    }
+
+
+    // Walks to the node at a 1-based level-order position of a complete tree, recording its parent
+    // The bits of the position below its leading 1 spell the path from the root (0 = left, 1 = right)
+    template <Comparable Tp>
+    constexpr typename binary_tree<Tp>::bitree_node*
+    binary_tree<Tp>::level_order_at(const unsigned position, bitree_node *&parent) const noexcept
+    {
+        parent = nullptr;
+        auto *curr = m_root;
+        for (auto bit = std::bit_width(position) - 1; bit > 0 && curr != nullptr; bit--)
         {
-            prev = curr;
-            curr = ( depth(curr->m_right) >= depth(curr->m_left()) )
-                    ? curr->m_right : curr->m_left;
+            parent = curr;
+            curr = ((position >> (bit - 1)) & 1u) ? curr->m_right : curr->m_left;
         }
-        return prev;
+        return curr;
     }
 
 
     // Overload of operator<< : writes the tree to an output stream in level order
     template <Comparable Tp>
-    std::ostream& operator<<(std::ostream &os, const binary_tree<Tp> &t) noexcept
+    std::ostream& operator<<(std::ostream &os, const binary_tree<Tp> &t)
     {
         if (t.m_root != nullptr)
         {
-            auto q { std::queue<bitree_node *const>{} };
-            q.push(m_root);
+            auto q { std::queue<const typename binary_tree<Tp>::bitree_node*>{} };
+            q.push(t.m_root);
             while (!q.empty())
             {
                 auto *curr = q.front();
@@ -267,65 +677,107 @@ namespace dsl::nonlinear::tree
     }
 
 
-    // Returns the node in the tree with the maximum value, if the tree is not empty
+    // Returns the node in the subtree with the maximum value
     template<Comparable Tp>
     constexpr const typename binary_tree<Tp>::bitree_node&
     binary_tree<Tp>::maxKey(const typename binary_tree<Tp>::bitree_node &root) const noexcept
     {
-        auto max;
-        auto maxval = std::numeric_limits<Tp>::min();
+        return *reduce(&root, &root,
+                       [](const bitree_node &node) { return &node; },
+                       [](const bitree_node *lhs, const bitree_node *rhs) { return (lhs->m_value < rhs->m_value) ? rhs : lhs; });
+    }
 
-        auto q { std::queue<bitree_node *const>{} };
-        q.push(root);
-        while (!q.empty())
-        {
-            auto *curr = q.front();
-            q.pop();
 
-            if (curr->m_value > maxval)
-            {
-                maxval = curr->m_value;
-                max = *curr;
-            }
+    // Returns the node in the subtree with the minimum value
+    template <Comparable Tp>
+    constexpr const typename binary_tree<Tp>::bitree_node&
+    binary_tree<Tp>::minKey(const typename binary_tree<Tp>::bitree_node &root) const noexcept
+    {
+        return *reduce(&root, &root,
+                       [](const bitree_node &node) { return &node; },
+                       [](const bitree_node *lhs, const bitree_node *rhs) { return (rhs->m_value < lhs->m_value) ? rhs : lhs; });
+    }
 
-            if (curr->m_left != nullptr)
-                q.push(curr->m_left);
-            if (curr->m_right != nullptr)
-                q.push(curr->m_right);
-        }
 
-        return max;
+    // Folds map over every node of the subtree, forking large subtrees when parallel is set
+    template <Comparable Tp>
+    template <typename Rp, std::invocable<const typename binary_tree<Tp>::bitree_node&> Map, std::invocable<Rp, Rp> Op>
+    Rp binary_tree<Tp>::reduce(const typename binary_tree<Tp>::bitree_node *const root, Rp identity, Map map, Op op, const bool parallel) const
+    {
+        if (!parallel)
+            return sequential_reduce(root, std::move(identity), map, op);
+        return parallel_reduce(root, identity, map, op, m_size);
     }
 
 
-    // Returns the node in the tree with the minimum value, if the tree is not empty
+    // reduce helper function; pre-order traversal with an explicit stack
     template <Comparable Tp>
-    constexpr const typename binary_tree<Tp>::typename binary_tree<Tp>::bitree_node&
-    binary_tree<Tp>::minKey(const typename binary_tree<Tp>::bitree_node &root) const noexcept
+    template <typename Rp, typename Map, typename Op>
+    Rp binary_tree<Tp>::sequential_reduce(const typename binary_tree<Tp>::bitree_node *const root, Rp result, Map &map, Op &op)
     {
-        auto min;
-        auto minval = std::numeric_limits<Tp>::max();
+        auto s { details::node_stack<const bitree_node*>{} };
+        if (root != nullptr)
+            s.push(root);
 
-        auto q { std::queue<bitree_node *const>{} };
-        q.push(root);
-        while (!q.empty())
+        while (!s.empty())
         {
-            auto *curr = q.front();
-            q.pop();
-
-            if (curr->m_value < minval)
-            {
-                minval = curr->m_value;
-                min = *curr;
-            }
+            const auto *curr = s.top();
+            s.pop();
 
-            if (curr->m_left != nullptr)
-                q.push(curr->m_left);
+            result = op(std::move(result), map(*curr));
             if (curr->m_right != nullptr)
-                q.push(curr->m_right);
+                s.push(curr->m_right);
+            if (curr->m_left != nullptr)
+                s.push(curr->m_left);
         }
+        return result;
+    }
 
-        return min;
+
+    // reduce helper function; folds the two subtrees of large trees concurrently
+    template <Comparable Tp>
+    template <typename Rp, typename Map, typename Op>
+    Rp binary_tree<Tp>::parallel_reduce(const typename binary_tree<Tp>::bitree_node *const root, const Rp &identity,
+                                        Map &map, Op &op, const int estimate) const
+    {
+        if (root == nullptr || estimate <= m_cutoff)
+            return sequential_reduce(root, identity, map, op);
+
+        auto left = identity, right = identity;
+        fork(estimate,
+             [&] { left = parallel_reduce(root->m_left, identity, map, op, estimate / 2); },
+             [&] { right = parallel_reduce(root->m_right, identity, map, op, estimate / 2); });
+        return op(op(map(*root), std::move(left)), std::move(right));
+    }
+
+
+    // Checks if two trees hold equal values in the same shape, comparing large subtrees concurrently
+    template <Comparable Tp>
+    bool binary_tree<Tp>::equals(const binary_tree<Tp> &rhs, const bool parallel) const
+    {
+        if (m_size != rhs.m_size)
+            return false;
+        return parallel ? parallel_same(m_root, rhs.m_root, m_size) : bitree_same(m_root, rhs.m_root);
+    }
+
+
+    // equals helper function
+    template <Comparable Tp>
+    bool binary_tree<Tp>::parallel_same(const typename binary_tree<Tp>::bitree_node *const lroot,
+                                        const typename binary_tree<Tp>::bitree_node *const rroot, const int estimate) const
+    {
+        if (estimate <= m_cutoff)
+            return bitree_same(lroot, rroot);
+        if (lroot == nullptr || rroot == nullptr)
+            return lroot == rroot;
+        if (lroot->m_value != rroot->m_value)
+            return false;
+
+        auto left = true, right = true;
+        fork(estimate,
+             [&] { left = parallel_same(lroot->m_left, rroot->m_left, estimate / 2); },
+             [&] { right = parallel_same(lroot->m_right, rroot->m_right, estimate / 2); });
+        return left && right;
     }
 
 
@@ -351,135 +803,224 @@ namespace dsl::nonlinear::tree
 
     // Finds the parent node of the given node
     template <Comparable Tp>
-    constexpr std::optional<typename binary_tree<Tp>::bitree_node&>
-    binary_tree<Tp>::parentOf(const typename binary_tree<Tp>::bitree_node &node) const noexcept
+    constexpr const typename binary_tree<Tp>::bitree_node*
+    binary_tree<Tp>::parentOf(const typename binary_tree<Tp>::bitree_node &node) const
+    { return parent_node(&node); }
+
+
+    // Finds the parent node of the node with the given value, if it exists
+    template <Comparable Tp>
+    constexpr const typename binary_tree<Tp>::bitree_node*
+    binary_tree<Tp>::parentOf(const Tp &value) const
     {
-        bitree_node *curr = nullptr, *prev = nullptr;
-        auto q { std::queue<bitree_node&>{} };
-        q.push(*m_root);
+        auto *node = find_node(value);
+        return (node == nullptr) ? nullptr : parent_node(node);
+    }
 
-        while (!q.empty())
+
+    // Finds the node with the value in the tree, if it exists
+    template <Comparable Tp>
+    constexpr const typename binary_tree<Tp>::bitree_node*
+    binary_tree<Tp>::find(const Tp &value) const
+    { return find_node(value); }
+
+
+    // Returns a node holding the value, or nullptr; O(1) expected when indexed
+    // The search returns the first such node in level order, but the index returns any of several equal values
+    template <Comparable Tp>
+    constexpr typename binary_tree<Tp>::bitree_node*
+    binary_tree<Tp>::find_node(const Tp &value) const
+    {
+        if (m_index != nullptr)
+            return m_index->find(value);
+
+        if (m_root != nullptr)
         {
-            curr = &(q.front());
-            q.pop();
+            auto q { std::queue<bitree_node*>{} };
+            q.push(m_root);
+            while (!q.empty())
+            {
+                auto *curr = q.front();
+                q.pop();
 
-            if (curr->m_value == node.m_value)
-                break;
-            prev = curr;
+                if (curr->m_value == value)
+                    return curr;
 
-            if (curr->m_left != nullptr)
-                q.push(*(curr->m_left));
-            if (curr->m_right != nullptr)
-                q.push(*(curr->m_right));
+                if (curr->m_left != nullptr)
+                    q.push(curr->m_left);
+                if (curr->m_right != nullptr)
+                    q.push(curr->m_right);
+            }
         }
-
-        return (prev == nullptr) ? std::nullopt : *prev;
+        return nullptr;
     }
 
 
-    // Finds the parent node of the node with the given value, if it exists
+    // Returns the parent of the given node, or nullptr for the root; O(1) expected when indexed
     template <Comparable Tp>
-    constexpr std::optional<typename binary_tree<Tp>::bitree_node&>
-    binary_tree<Tp>::parentOf(const Tp &value) const noexcept
+    constexpr typename binary_tree<Tp>::bitree_node*
+    binary_tree<Tp>::parent_node(const typename binary_tree<Tp>::bitree_node *const node) const
     {
-        auto q { std::queue<bitree_node&>{} };
-        q.push(m_root);
-        bool found = false;
+        if (m_index != nullptr)
+            return m_index->parent(node);
 
-        bitree_node *curr = nullptr, *prev = nullptr;
-        while (!q.empty())
+        if (m_root != nullptr)
         {
-            curr = &(q.front());
-            q.pop();
-
-            if (curr->m_value == value)
+            auto q { std::queue<bitree_node*>{} };
+            q.push(m_root);
+            while (!q.empty())
             {
-                found = true;
-                break;
-            }
+                auto *curr = q.front();
+                q.pop();
 
-            prev = curr;
+                if (curr->m_left == node || curr->m_right == node)
+                    return curr;
 
-            if (curr->m_left != nullptr)
-                q.push(*(curr->m_left));
-            if (curr->m_right != nullptr)
-                q.push(*(curr->m_right));
+                if (curr->m_left != nullptr)
+                    q.push(curr->m_left);
+                if (curr->m_right != nullptr)
+                    q.push(curr->m_right);
+            }
         }
-        return (prev == nullptr || !found) ? std::nullopt : *prev;
+        return nullptr;
     }
 
 
-    // Finds the node with the value in the tree, if it exists
+    // Overwrites the value held by a node, keeping the index current
     template <Comparable Tp>
-    constexpr std::optional<typename binary_tree<Tp>::bitree_node&>
-    binary_tree<Tp>::find(const Tp &value) const noexcept {
-        if (m_root != nullptr && m_root->m_value == value)
-            return *m_root;
-
-        auto p = parentOf(value);
-        if (p) {
-            auto parent = *p;
-            if (parent.m_left != nullptr && parent.m_right != nullptr)
-                return (parent.m_left->m_value == value)
-                       ? *(parent.m_left) : *(parent.m_right);
-            return (parent.m_left != nullptr) ? *(parent.m_left) : *(parent.m_right);
-        }
-        return std::nullopt;
+    constexpr void binary_tree<Tp>::assign_value(typename binary_tree<Tp>::bitree_node *const node, const Tp &value)
+    {
+        auto old_value = node->m_value;
+        node->m_value = value;
+        if (m_index != nullptr)
+            m_index->revalued(node, old_value);
     }
 
 
-    // is_complete helper function
+    // Exchanges the values held by two nodes, keeping the index current
     template <Comparable Tp>
-    constexpr bool binary_tree<Tp>::complete(typename binary_tree<Tp>::bitree_node *const node, const int index) const noexcept
+    constexpr void binary_tree<Tp>::swap_values(typename binary_tree<Tp>::bitree_node *const lhs,
+                                                typename binary_tree<Tp>::bitree_node *const rhs)
     {
-        if (node == nullptr) return true;
-        if (index >= m_size) return false;
-        return complete(node->m_left, 2 * index + 1) &&
-               complete(node->m_right, 2 * index + 2);
+        using std::swap;
+        swap(lhs->m_value, rhs->m_value);
+        if (m_index != nullptr)
+        {
+            m_index->revalued(lhs, rhs->m_value);
+            m_index->revalued(rhs, lhs->m_value);
+        }
     }
 
 
-    // is_perfect helper function
+    // Moves the last node in level order into the given node and frees the last node
+    // Returns the given node, or nullptr if it was itself the last node and has been freed
     template <Comparable Tp>
-    constexpr bool binary_tree<Tp>::perfect(typename binary_tree<Tp>::bitree_node *const node, const int depth, const int level) const noexcept
+    constexpr typename binary_tree<Tp>::bitree_node*
+    binary_tree<Tp>::erase_node(typename binary_tree<Tp>::bitree_node *node)
     {
-        if (node == nullptr) return true;
+        bitree_node *parent = nullptr;
+        auto *last = level_order_at(static_cast<unsigned>(m_size), parent);
 
-        if (node->m_left != nullptr && node->m_right != nullptr)
-            return depth == level + 1;
+        if (node != last)
+            assign_value(node, last->m_value);
+        else
+            node = nullptr;
 
-        if (node->m_left == nullptr || node->m_right == nullptr)
-            return false;
+        if (parent == nullptr)
+            m_root = nullptr;
+        else if (parent->m_right == last)
+            parent->m_right = nullptr;
+        else
+            parent->m_left = nullptr;
 
-        return perfect(node->m_left, depth, level + 1) &&
-               perfect(node->m_right, depth, level + 1);
+        if (m_index != nullptr)
+            m_index->unlinked(last);
+        delete last;
+
+        m_size--;
+        return node;
     }
-    
-    
-    // Checks if the tree is balanced (difference between left and right depth is less than or equal to 1)
+
+
+    // Computes height, size, leaf count and the shape properties of a subtree in one bottom-up pass
+    // In parallel mode subtrees larger than the cutoff are split into tasks on the shared pool
     template <Comparable Tp>
-    constexpr bool binary_tree<Tp>::is_balanced(typename binary_tree<Tp>::bitree_node *const node) const noexcept
+    tree_stats binary_tree<Tp>::stats(typename binary_tree<Tp>::bitree_node *const node, const bool parallel) const
     {
-        if (node == nullptr) return true;
-        if (abs(depth(node->m_left) - depth(node->m_right)) <= 1 &&
-            is_balanced(node->m_left) &&
-            is_balanced(node->m_right))
-            return true;
-        return false;
+        return parallel ? parallel_stats(node, m_size) : sequential_stats(node);
     }
 
 
-    // Checks if the tree is full (every node other than leaves have 2 children)
+    // Derives a node's statistics from those of its left and right subtrees
     template <Comparable Tp>
-    constexpr bool binary_tree<Tp>::is_full(typename binary_tree<Tp>::bitree_node *const node) const noexcept
+    constexpr tree_stats binary_tree<Tp>::combine(const typename binary_tree<Tp>::bitree_node *const node,
+                                                  const tree_stats &l, const tree_stats &r) noexcept
     {
-        if (node == nullptr || (node->m_left == nullptr || node->m_right == nullptr))
-            return true;
+        auto result = tree_stats{};
+        result.m_height = 1 + std::max(l.m_height, r.m_height);
+        result.m_size = 1 + l.m_size + r.m_size;
+        result.m_leaves = (node->m_left == nullptr && node->m_right == nullptr) ? 1 : l.m_leaves + r.m_leaves;
+        result.m_balanced = l.m_balanced && r.m_balanced && std::abs(l.m_height - r.m_height) <= 1;
+        result.m_full = l.m_full && r.m_full && ((node->m_left == nullptr) == (node->m_right == nullptr));
+        result.m_perfect = l.m_perfect && r.m_perfect && l.m_height == r.m_height;
+
+        // Either the left side is perfect and the last level ends on the right, or vice versa one level lower
+        result.m_complete = (l.m_perfect && r.m_complete && l.m_height == r.m_height) ||
+                            (l.m_complete && r.m_perfect && l.m_height == r.m_height + 1);
+        return result;
+    }
 
-        if (node->m_left != nullptr && node->m_right != nullptr)
-            return is_full(node->m_left) && is_full(node->m_right);
 
-        return false;
+    // stats helper function; post-order traversal with an explicit stack of partial results
+    template <Comparable Tp>
+    tree_stats binary_tree<Tp>::sequential_stats(typename binary_tree<Tp>::bitree_node *const node) const
+    {
+        auto s { details::node_stack<bitree_node*>{} };
+        auto results { details::node_stack<tree_stats>{} };
+        bitree_node *curr = node, *last = nullptr;
+
+        while (curr != nullptr || !s.empty())
+        {
+            if (curr != nullptr)
+            {
+                s.push(curr);
+                curr = curr->m_left;
+                continue;
+            }
+
+            auto *top = s.top();
+            if (top->m_right != nullptr && top->m_right != last)
+            {
+                curr = top->m_right;
+                continue;
+            }
+
+            // Children finish before their parent, so their results sit on top (right above left)
+            auto r = tree_stats{}, l = tree_stats{};
+            if (top->m_right != nullptr) { r = results.top(); results.pop(); }
+            if (top->m_left != nullptr)  { l = results.top(); results.pop(); }
+            results.push(combine(top, l, r));
+
+            last = top;
+            s.pop();
+        }
+
+        return results.empty() ? tree_stats{} : results.top();
+    }
+
+
+    // stats helper function; gathers the two subtrees of large trees concurrently
+    template <Comparable Tp>
+    tree_stats binary_tree<Tp>::parallel_stats(typename binary_tree<Tp>::bitree_node *const node, const int estimate) const
+    {
+        if (node == nullptr || estimate <= m_cutoff)
+            return sequential_stats(node);
+
+        auto l = tree_stats{}, r = tree_stats{};
+        fork(estimate,
+             [&] { l = parallel_stats(node->m_left, estimate / 2); },
+             [&] { r = parallel_stats(node->m_right, estimate / 2); });
+        return combine(node, l, r);
     }
 
 
@@ -495,76 +1036,154 @@ namespace dsl::nonlinear::tree
     }
 
 
-    // Constructs a new node with the given value and inserts into the rightmost leaf of the tree
+    // Constructs a new node with the given value and inserts it at the next level-order position
     // For a binary tree with max capacity == std::numeric_limits<Tp>::max(), will always return true
     template <Comparable Tp>
     constexpr bool binary_tree<Tp>::push(const Tp &value)
+    { return push_node(make_node(value)); }
+
+
+    // As push, moving the value into the new node
+    template <Comparable Tp>
+    constexpr bool binary_tree<Tp>::push(Tp &&value)
+    { return push_node(make_node(std::move(value))); }
+
+
+    // Links a new node at the next level-order position
+    template <Comparable Tp>
+    constexpr bool binary_tree<Tp>::push_node(bitree_node *const node)
     {
-        if (m_root == nullptr)
-            m_root = new bitree_node<Tp>(value);
+        // The next level-order position is m_size + 1; its parent is found in O(log n)
+        const auto position = static_cast<unsigned>(m_size) + 1;
+        bitree_node *parent = nullptr;
+        level_order_at(position, parent);
+
+        if (parent == nullptr)
+            m_root = node;
+        else if (position & 1u)
+            parent->m_right = node;
         else
+            parent->m_left = node;
+
+        if (m_index != nullptr)
+            m_index->linked(node, parent);
+        m_size++;
+        return true;
+    }
+
+
+    // Removes the node in the tree with the given value
+    template <Comparable Tp>
+    constexpr bool binary_tree<Tp>::pop(const Tp &value)
+    {
+        auto *node = find_node(value);
+        if (node == nullptr)
+            return false;
+
+        erase_node(node);
+        return true;
+    }
+
+
+    // Builds the lookup index over the current nodes; push and pop keep it current from then on
+    template <Comparable Tp>
+    void binary_tree<Tp>::enable_index() requires Hashable<Tp>
+    {
+        if (m_index != nullptr) return;
+
+        m_index = new bitree_index();
+        if (m_root != nullptr)
         {
             auto q { std::queue<bitree_node*>{} };
             q.push(m_root);
+            m_index->linked(m_root, nullptr);
 
             while (!q.empty())
             {
                 auto *curr = q.front();
                 q.pop();
 
-                if (curr->m_left == nullptr)
-                {
-                    curr->m_left = new bitree_node<Tp>(value);
-                    break;
-                }
-                else
-                    q.push(curr->m_left);
-
-                if (curr->m_right == nullptr)
+                for (auto *child : {curr->m_left, curr->m_right})
                 {
-                    curr->m_right = new bitree_node<Tp>(value);
-                    break;
+                    if (child == nullptr) continue;
+                    m_index->linked(child, curr);
+                    q.push(child);
                 }
-                else
-                    q.push(curr->m_right);
             }
         }
-        m_size++;
-        return true;
     }
 
 
-    // Removes the node in the tree with the given value
+    // Drops the lookup index; find and parentOf fall back to level-order search
     template <Comparable Tp>
-    constexpr bool binary_tree<Tp>::pop(const Tp &value)
+    void binary_tree<Tp>::disable_index() noexcept
+    {
+        delete m_index;
+        m_index = nullptr;
+    }
+
+
+    // Allocates new nodes from a slab; nodes already in the tree stay where they are
+    template <Comparable Tp>
+    void binary_tree<Tp>::enable_slab()
     {
-        auto *last = last_level_order();
-        if (m_root != nullptr && m_root->m_value == value)
-            m_root->m_value = last->m_value;
+        if (m_slab != nullptr) return;
 
-        else
+        m_slab = new node_slab();
+        m_slab_sole = (m_root == nullptr);
+    }
+
+
+    // Returns to one allocation per node; blocks of the old slab are freed as the nodes in them are
+    template <Comparable Tp>
+    void binary_tree<Tp>::disable_slab() noexcept
+    {
+        delete m_slab;
+        m_slab = nullptr;
+        m_slab_sole = false;
+    }
+
+
+    // Falls back to new when there is no slab or it cannot take the node; the tree then no longer owns all its nodes' blocks
+    // Without a slab there is no flag to clear, so parallel builds, which never use one, call this from many threads
+    template <Comparable Tp>
+    template <typename Node, typename... Args>
+    typename binary_tree<Tp>::bitree_node* binary_tree<Tp>::create_node(Args &&...args) const
+    {
+        if (m_slab == nullptr)
+            return new Node(std::forward<Args>(args)...);
+
+        auto *slot = m_slab->allocate(sizeof(details::pooled_node<Node>));
+        if (slot == nullptr)
         {
-            auto p = parentOf(value);
-            if (p)
-            {
-                auto parent = *p;
-                bitree_node *node = nullptr;
-                if (parent.m_left != nullptr && parent.m_right != nullptr)
-                    node = (parent.m_left->m_value == value) ? parent.m_left : parent.m_right;
-                else
-                    node = (parent.m_left != nullptr) ? parent.m_left : parent.m_right;
-
-                node->m_value = last->m_value;
-            }
-            else
-                return false;
+            m_slab_sole = false;
+            return new Node(std::forward<Args>(args)...);
         }
 
-        delete last;
-        last = nullptr;
+        try { return ::new (slot) details::pooled_node<Node>(std::forward<Args>(args)...); }
+        catch (...)
+        {
+            node_arena::release(slot);
+            throw;
+        }
+    }
 
-        size--;
-        return true;
+
+    // Splices rhs's slab into this one only if each tree holds exactly the nodes of its own slab
+    template <Comparable Tp>
+    void binary_tree<Tp>::share_slab(binary_tree &rhs, const bool consumed) noexcept
+    {
+        if (rhs.m_root == nullptr && (consumed || m_root == nullptr))
+            return;
+
+        if (consumed && m_slab != nullptr && m_slab_sole && rhs.m_slab != nullptr && rhs.m_slab_sole)
+        {
+            m_slab->splice(*rhs.m_slab);
+            return;
+        }
+
+        m_slab_sole = false;
+        rhs.m_slab_sole = false;
     }
 
 
@@ -572,34 +1191,32 @@ namespace dsl::nonlinear::tree
     template <Comparable Tp>
     constexpr bool binary_tree<Tp>::hasPath(typename binary_tree<Tp>::bitree_node *const root,
                                             const typename binary_tree<Tp>::bitree_node &node,
-                                            std::stack<typename binary_tree<Tp>::bitree_node*> &nodes) const noexcept
+                                            std::stack<typename binary_tree<Tp>::bitree_node*> &nodes) const
     {
         if (root == nullptr)
             return false;
-        nodes.push(root);
-
-        if (root->m_value == node.m_value)
-        {
-            nodes.pop();
+        if (root == &node)
             return true;
-        }
 
+        nodes.push(root);
         if (hasPath(root->m_left, node, nodes) ||
             hasPath(root->m_right, node, nodes))
             return true;
 
+        nodes.pop();
         return false;
     }
 
 
-    // Returns a stack of all the nodes, beginning from the root of the tree, to the given node
+    // Returns a stack of all the nodes, beginning from the root of the tree, to (but excluding) the given node
     template <Comparable Tp>
     std::optional<std::stack<typename binary_tree<Tp>::bitree_node*>>
-    binary_tree<Tp>::pathTo(typename binary_tree<Tp>::bitree_node *const node) const noexcept
+    binary_tree<Tp>::pathTo(typename binary_tree<Tp>::bitree_node *const node) const
     {
         auto s { std::stack<bitree_node*>{} };
-        auto b = hasPath(m_root, node, s);
-        return (b) ? s : std::nullopt;
+        if (node == nullptr || !hasPath(m_root, *node, s))
+            return std::nullopt;
+        return s;
     }
 
 
@@ -607,12 +1224,22 @@ namespace dsl::nonlinear::tree
     template <Comparable Tp>
     constexpr void binary_tree<Tp>::vectorize(typename binary_tree<Tp>::bitree_node *const root, std::vector<typename binary_tree<Tp>::bitree_node*> &vector) const noexcept
     {
-        if (root == nullptr)
-            return;
+        auto s { details::node_stack<bitree_node*>{} };
+        auto *curr = root;
+
+        while (curr != nullptr || !s.empty())
+        {
+            while (curr != nullptr)
+            {
+                s.push(curr);
+                curr = curr->m_left;
+            }
 
-        vectorize(root->m_left, vector);
-        vector.push_back(root);
-        vectorize(root->m_right, vector);
+            curr = s.top();
+            s.pop();
+            vector.push_back(curr);
+            curr = curr->m_right;
+        }
     }
 
 
@@ -622,7 +1249,7 @@ namespace dsl::nonlinear::tree
     binary_tree<Tp>::toVector(const typename binary_tree<Tp>::bitree_node &root) const noexcept
     {
         auto v { std::vector<bitree_node*>{} };
-        vectorize(root, v);
+        vectorize(const_cast<bitree_node*>(&root), v);
         return v;
     }
 
@@ -631,29 +1258,39 @@ namespace dsl::nonlinear::tree
 
     // operator== helper function
     template <Comparable Tp>
-    constexpr bool bitree_same(details::bitree_node<Tp> *const lroot, details::bitree_node<Tp> *const rroot) noexcept
+    constexpr bool bitree_same(const details::bitree_node<Tp> *const lroot, const details::bitree_node<Tp> *const rroot)
     {
-        if (lroot == nullptr && rroot == nullptr)
-            return true;
+        using bitree_node = details::bitree_node<Tp>;
+
+        auto s { details::node_stack<std::pair<const bitree_node*, const bitree_node*>>{} };
+        s.push({lroot, rroot});
 
-        if (lroot != nullptr && rroot != nullptr) {
-            return lroot->m_value == rroot->m_value &&
-                   bitree_same(lroot->m_left, rroot->m_left) &&
-                   bitree_same(lroot->m_right, rroot->m_right);
+        while (!s.empty())
+        {
+            auto [lhs, rhs] = s.top();
+            s.pop();
+
+            if (lhs == nullptr && rhs == nullptr)
+                continue;
+            if (lhs == nullptr || rhs == nullptr || lhs->m_value != rhs->m_value)
+                return false;
+
+            s.push({lhs->m_right, rhs->m_right});
+            s.push({lhs->m_left, rhs->m_left});
         }
-        return false;
+        return true;
     }
 
 
     template <Comparable Tp>
     [[nodiscard]] constexpr bool operator==(const binary_tree<Tp> &lhs,
-                              const binary_tree<Tp> &rhs) noexcept
-    { return lhs.size() == rhs.size() && bitree_same(lhs.m_root, rhs.m_root); }
+                              const binary_tree<Tp> &rhs)
+    { return lhs.size() == rhs.size() && bitree_same(lhs.root(), rhs.root()); }
 
 
     template <Comparable Tp>
     [[nodiscard]] constexpr bool operator!=(const binary_tree<Tp> &lhs,
-                                            const binary_tree<Tp> &rhs) noexcept
+                                            const binary_tree<Tp> &rhs)
     { return !operator==(lhs, rhs); }
 
 
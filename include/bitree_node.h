@@ -0,0 +1,145 @@
+#ifndef DS_GRAPH_BITREE_NODE_H
+#define DS_GRAPH_BITREE_NODE_H
+
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "node_arena.h"
+#include "traits.h"
+
+
+namespace dsl::nonlinear::tree
+{
+    namespace details
+    {
+        template <typename Node>
+        struct pooled_node;
+
+
+        template <Comparable Tp>
+        struct bitree_node
+        {
+            // No-throw constructors
+            constexpr bitree_node() noexcept = default;
+            constexpr explicit bitree_node(const Tp &value) noexcept
+                : m_value(value),
+                  m_left(nullptr),
+                  m_right(nullptr) {}
+
+            constexpr explicit bitree_node(Tp &&value) noexcept(std::is_nothrow_move_constructible_v<Tp>)
+                : m_value(std::move(value)),
+                  m_left(nullptr),
+                  m_right(nullptr) {}
+
+            // Copy constructor; copies the child links as well, but not where the node itself is stored
+            constexpr bitree_node(const bitree_node &rhs) noexcept(std::is_nothrow_copy_constructible_v<Tp>)
+                : m_value(rhs.m_value),
+                  m_left(rhs.m_left),
+                  m_right(rhs.m_right) {}
+
+            // No-throw copy assignment
+            constexpr bitree_node& operator=(const bitree_node &rhs) noexcept
+            {
+                if (this == &rhs) return *this;
+                m_value = rhs.m_value;
+                m_left = rhs.m_left;
+                m_right = rhs.m_right;
+                return *this;
+            }
+
+            // Delegate resource destruction responsibility to the containing class
+            virtual ~bitree_node() noexcept = default;
+
+            // Size of the most derived node type, i.e. of the storage clone_into needs
+            [[nodiscard]] virtual std::size_t footprint() const noexcept
+            { return sizeof(bitree_node); }
+
+            // Constructs a childless copy of this node, including the augmented data of derived node types, in the
+            // arena slot at where, or in its own allocation if where is nullptr
+            [[nodiscard]] virtual bitree_node* clone_into(void *const where) const
+            { return copy_of(*this, where); }
+
+            // Allocates a childless copy of this node
+            [[nodiscard]] bitree_node* clone() const
+            { return clone_into(nullptr); }
+
+            Tp m_value;
+            bitree_node *m_left, *m_right;
+
+        protected:
+            // clone_into helper function for every node type
+            template <typename Node>
+            [[nodiscard]] static bitree_node* copy_of(const Node &node, void *const where)
+            {
+                Node *copy = (where != nullptr) ? ::new (where) pooled_node<Node>(node) : new Node(node);
+                copy->m_left = copy->m_right = nullptr;
+                return copy;
+            }
+
+        };  // struct bitree_node
+
+
+
+        // A node of type Node that sits in a node_arena slot rather than its own allocation. Being pooled is part of
+        // the node's dynamic type, so it takes no storage, and deleting the node hands the slot back to its arena
+        template <typename Node>
+        struct pooled_node final : public Node
+        {
+            using Node::Node;
+
+            explicit pooled_node(const Node &node)
+                : Node(node) {}
+
+            void operator delete(pooled_node *node, std::destroying_delete_t) noexcept
+            {
+                node->~pooled_node();
+                node_arena::release(node);
+            }
+
+        };  // struct pooled_node
+
+
+
+        // Traversal stack; holds its first Capacity entries inline so only unusually deep trees touch the heap
+        template <typename Tp, int Capacity = 64>
+        class node_stack
+        {
+        public:
+            constexpr void push(const Tp &value)
+            {
+                if (m_size < Capacity)
+                    m_inline[m_size] = value;
+                else
+                    m_overflow.push_back(value);
+                m_size++;
+            }
+
+            constexpr void pop() noexcept
+            {
+                if (m_size > Capacity)
+                    m_overflow.pop_back();
+                m_size--;
+            }
+
+            [[nodiscard]] constexpr Tp& top() noexcept
+            { return (m_size <= Capacity) ? m_inline[m_size - 1] : m_overflow.back(); }
+
+            [[nodiscard]] constexpr bool empty() const noexcept     { return m_size == 0; }
+
+        private:
+            Tp m_inline[Capacity] {};
+            std::vector<Tp> m_overflow;
+            int m_size = 0;
+
+        };  // class node_stack
+
+    }   // namespace details
+
+}   // namespace nonlinear::tree
+
+
+#endif //DS_GRAPH_BITREE_NODE_H
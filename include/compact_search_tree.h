@@ -0,0 +1,507 @@
+#ifndef DS_GRAPH_COMPACT_SEARCH_TREE_H
+#define DS_GRAPH_COMPACT_SEARCH_TREE_H
+
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "traits.h"
+
+
+namespace dsl::nonlinear::tree
+{
+    namespace details
+    {
+        // Plain pool entry: no vtable, and the children are positions in the pool rather than pointers
+        template <Comparable Tp>
+        struct compact_node
+        {
+            static constexpr const std::uint32_t null_index = std::numeric_limits<std::uint32_t>::max();
+
+            constexpr explicit compact_node(const Tp &value)
+                : m_value(value) {}
+
+            constexpr explicit compact_node(Tp &&value) noexcept(std::is_nothrow_move_constructible_v<Tp>)
+                : m_value(std::move(value)) {}
+
+            Tp m_value;
+            std::uint32_t m_left = null_index, m_right = null_index;
+
+        };  // struct compact_node
+
+    }   // namespace details
+
+
+
+    // Search tree whose nodes sit contiguously in one pool and link by 32-bit index, so each key carries 8 bytes of links
+    // Balanced as a scapegoat tree (alpha = 2/3), which keeps no per-node balance data: a push that lands too deep rebuilds
+    // the unbalanced subtree above it, and the whole tree is rebuilt once a third of it has been popped
+    // A pop moves the last node of the pool into the freed slot, so the pool never has holes; a side array of parent
+    // indices, which searches never read, lets it repoint that node in O(1)
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare = three_way_compare> requires std::movable<Tp>
+    class compact_search_tree
+    {
+    public:
+        using compact_node = typename details::compact_node<Tp>;
+        using index_type = std::uint32_t;
+
+        static constexpr const index_type null_index = compact_node::null_index;
+
+
+        //****** Member Functions ******//
+
+        // No-throw constructor
+        compact_search_tree() noexcept = default;
+
+        // Copy constructor; the pool is copied in one pass, links included
+        compact_search_tree(const compact_search_tree&) = default;
+
+        // Move constructor
+        compact_search_tree(compact_search_tree &&rhs) noexcept
+            : compact_search_tree()
+        { swap(rhs); }
+
+        // Pass-by-value copy/move assignment
+        compact_search_tree& operator=(compact_search_tree rhs) noexcept
+        { swap(rhs); return *this; }
+
+        ~compact_search_tree() = default;
+        void swap(compact_search_tree &rhs) noexcept;
+
+
+        //****** Capacity ******//
+        [[nodiscard]] int size() const noexcept       { return static_cast<int>(m_pool.size()); }
+        [[nodiscard]] bool empty() const noexcept     { return m_pool.empty(); }
+        void reserve(const int n);
+
+
+        //****** Access ******//
+        template <typename Kp = Tp> requires ThreeWayComparator<Compare, Kp, Tp>
+        [[nodiscard]] const Tp* find(const Kp&) const noexcept;
+
+        template <typename Kp = Tp> requires ThreeWayComparator<Compare, Kp, Tp>
+        [[nodiscard]] bool contains(const Kp &value) const noexcept   { return find(value) != nullptr; }
+
+        template <typename Kp = Tp> requires ThreeWayComparator<Compare, Kp, Tp>
+        [[nodiscard]] const Tp* lower_bound(const Kp&) const noexcept;
+
+        template <std::invocable<const Tp&> Fn>
+        void for_each(Fn &&fn) const
+        { visit(m_root, fn); }
+
+
+        //****** Modifiers ******//
+        bool push(const Tp &value)    { return insert(value); }
+        bool push(Tp &&value)         { return insert(std::move(value)); }
+        bool pop(const Tp&);
+        void clear() noexcept;
+
+        // Builds the value from args once and moves it into its node
+        template <typename... Args> requires std::constructible_from<Tp, Args...>
+        bool emplace(Args &&...args)
+        { return push(Tp(std::forward<Args>(args)...)); }
+
+
+    private:
+        // Bound on the depth of any node: floor(log base 3/2 of 2^32) is 54
+        static constexpr const int max_depth = 64;
+
+        std::vector<compact_node> m_pool;
+        std::vector<index_type> m_parent;   // m_parent[i] is the parent of m_pool[i], or null_index for the root
+        index_type m_root = null_index;
+        std::size_t m_max_size = 0;     // largest size since the whole tree was last rebuilt
+
+        template <typename Kp>
+        [[nodiscard]] static constexpr auto compare(const Kp &key, const Tp &value)
+        { return Compare{}(key, value); }
+
+        [[nodiscard]] static int depth_limit(std::size_t) noexcept;
+
+        template <typename Vp>
+        bool insert(Vp&&);
+        void release(index_type);
+
+        [[nodiscard]] std::size_t count(index_type) const noexcept;
+        [[nodiscard]] index_type rebuild(index_type, std::size_t);
+        void flatten(index_type, std::vector<index_type>&) const;
+        index_type relink(const index_type*, std::size_t, index_type) noexcept;
+        void replace_child(index_type, index_type, index_type) noexcept;
+
+        template <typename Fn>
+        void visit(index_type, Fn&) const;
+
+    };  // class compact_search_tree
+
+
+
+    //************ Member Function Implementations ************//
+
+
+    // Member swap function
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare> requires std::movable<Tp>
+    void compact_search_tree<Tp, Compare>::swap(compact_search_tree &rhs) noexcept
+    {
+        using std::swap;
+        swap(m_pool, rhs.m_pool);
+        swap(m_parent, rhs.m_parent);
+        swap(m_root, rhs.m_root);
+        swap(m_max_size, rhs.m_max_size);
+    }
+
+
+    // Reserves room for n nodes in the pool and in the parent array
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare> requires std::movable<Tp>
+    void compact_search_tree<Tp, Compare>::reserve(const int n)
+    {
+        m_pool.reserve(static_cast<std::size_t>(n));
+        m_parent.reserve(static_cast<std::size_t>(n));
+    }
+
+
+    // Returns the stored value equivalent to value, if it exists
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare> requires std::movable<Tp>
+    template <typename Kp> requires ThreeWayComparator<Compare, Kp, Tp>
+    const Tp* compact_search_tree<Tp, Compare>::find(const Kp &value) const noexcept
+    {
+        auto curr = m_root;
+        while (curr != null_index)
+        {
+            const auto &node = m_pool[curr];
+            const auto order = compare(value, node.m_value);
+            if (order == 0)
+                return &node.m_value;
+            curr = (order < 0) ? node.m_left : node.m_right;
+        }
+        return nullptr;
+    }
+
+
+    // Returns the smallest value not less than value, or nullptr if there is none
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare> requires std::movable<Tp>
+    template <typename Kp> requires ThreeWayComparator<Compare, Kp, Tp>
+    const Tp* compact_search_tree<Tp, Compare>::lower_bound(const Kp &value) const noexcept
+    {
+        const Tp *bound = nullptr;
+        auto curr = m_root;
+        while (curr != null_index)
+        {
+            const auto &node = m_pool[curr];
+            if (compare(value, node.m_value) > 0)
+                curr = node.m_right;
+            else
+            {
+                bound = &node.m_value;
+                curr = node.m_left;
+            }
+        }
+        return bound;
+    }
+
+
+    // Removes a value, unlinking its in-order successor in its place if it has two children
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare> requires std::movable<Tp>
+    bool compact_search_tree<Tp, Compare>::pop(const Tp &value)
+    {
+        auto *link = &m_root;
+        while (*link != null_index)
+        {
+            const auto order = compare(value, m_pool[*link].m_value);
+            if (order == 0)
+                break;
+            link = (order < 0) ? &m_pool[*link].m_left : &m_pool[*link].m_right;
+        }
+
+        if (*link == null_index)
+            return false;
+
+        auto target = *link;
+        auto &node = m_pool[target];
+        if (node.m_left == null_index)
+            *link = node.m_right;
+        else if (node.m_right == null_index)
+            *link = node.m_left;
+        else
+        {
+            auto *successor = &node.m_right;
+            while (m_pool[*successor].m_left != null_index)
+                successor = &m_pool[*successor].m_left;
+
+            target = *successor;
+            node.m_value = std::move(m_pool[target].m_value);
+            link = successor;
+            *link = m_pool[target].m_right;
+        }
+
+        // The spliced-in child, if any, takes over the unlinked node's parent
+        if (*link != null_index)
+            m_parent[*link] = m_parent[target];
+        release(target);
+
+        if (3 * m_pool.size() < 2 * m_max_size)
+        {
+            m_root = rebuild(m_root, m_pool.size());
+            m_max_size = m_pool.size();
+        }
+        return true;
+    }
+
+
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare> requires std::movable<Tp>
+    void compact_search_tree<Tp, Compare>::clear() noexcept
+    {
+        m_pool.clear();
+        m_parent.clear();
+        m_root = null_index;
+        m_max_size = 0;
+    }
+
+
+    // Deepest a new node may land in a tree of n nodes before the subtree above it is rebuilt
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare> requires std::movable<Tp>
+    int compact_search_tree<Tp, Compare>::depth_limit(const std::size_t n) noexcept
+    { return static_cast<int>(std::log(static_cast<double>(n)) / std::log(1.5)); }
+
+
+    // push helper function; appends the node to the pool, then rebuilds at the scapegoat if it landed too deep
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare> requires std::movable<Tp>
+    template <typename Vp>
+    bool compact_search_tree<Tp, Compare>::insert(Vp &&value)
+    {
+        if (m_pool.size() == null_index)
+            throw std::length_error("Cannot index more nodes than fit in 32 bits.");
+
+        auto path { std::array<index_type, max_depth>{} };
+        auto depth = 0;
+        auto left = false;
+
+        auto curr = m_root;
+        while (curr != null_index)
+        {
+            const auto order = compare(value, m_pool[curr].m_value);
+            if (order == 0)
+                return false;
+            path[depth++] = curr;
+            left = order < 0;
+            curr = (left) ? m_pool[curr].m_left : m_pool[curr].m_right;
+        }
+
+        const auto node = static_cast<index_type>(m_pool.size());
+        m_parent.push_back((depth == 0) ? null_index : path[depth - 1]);
+        try
+        {
+            m_pool.emplace_back(std::forward<Vp>(value));
+        }
+        catch (...)
+        {
+            m_parent.pop_back();
+            throw;
+        }
+        m_max_size = std::max(m_max_size, m_pool.size());
+
+        if (depth == 0)
+            m_root = node;
+        else
+            (left ? m_pool[path[depth - 1]].m_left : m_pool[path[depth - 1]].m_right) = node;
+
+        if (depth <= depth_limit(m_pool.size()))
+            return true;
+
+        // Walk back up to the first ancestor with a child holding more than 2/3 of its subtree
+        auto child = node;
+        auto child_size = std::size_t{1};
+        for (auto i = depth - 1; i >= 0; i--)
+        {
+            const auto parent = path[i];
+            const auto sibling = (m_pool[parent].m_left == child) ? m_pool[parent].m_right : m_pool[parent].m_left;
+            const auto parent_size = child_size + 1 + count(sibling);
+
+            if (3 * child_size > 2 * parent_size)
+            {
+                const auto above = m_parent[parent];
+                replace_child(above, parent, rebuild(parent, parent_size));
+                break;
+            }
+
+            child = parent;
+            child_size = parent_size;
+        }
+        return true;
+    }
+
+
+    // Frees an unlinked slot by moving the last node of the pool into it and repointing that node's parent and children
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare> requires std::movable<Tp>
+    void compact_search_tree<Tp, Compare>::release(const index_type slot)
+    {
+        const auto last = static_cast<index_type>(m_pool.size() - 1);
+        if (slot != last)
+        {
+            const auto &moved = m_pool[last];
+            replace_child(m_parent[last], last, slot);
+            if (moved.m_left != null_index)
+                m_parent[moved.m_left] = slot;
+            if (moved.m_right != null_index)
+                m_parent[moved.m_right] = slot;
+
+            m_parent[slot] = m_parent[last];
+            m_pool[slot] = std::move(m_pool[last]);
+        }
+        m_pool.pop_back();
+        m_parent.pop_back();
+    }
+
+
+    // Points the link that held child (in parent, or the root if parent is null_index) at replacement
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare> requires std::movable<Tp>
+    void compact_search_tree<Tp, Compare>::replace_child(const index_type parent, const index_type child,
+                                                         const index_type replacement) noexcept
+    {
+        if (parent == null_index)
+            m_root = replacement;
+        else
+            (m_pool[parent].m_left == child ? m_pool[parent].m_left : m_pool[parent].m_right) = replacement;
+    }
+
+
+    // Counts the nodes in a subtree
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare> requires std::movable<Tp>
+    std::size_t compact_search_tree<Tp, Compare>::count(const index_type root) const noexcept
+    {
+        auto s { std::array<index_type, max_depth>{} };
+        auto top = 0;
+        auto result = std::size_t{0};
+        if (root != null_index)
+            s[top++] = root;
+
+        while (top > 0)
+        {
+            const auto &node = m_pool[s[--top]];
+            result++;
+            if (node.m_right != null_index)
+                s[top++] = node.m_right;
+            if (node.m_left != null_index)
+                s[top++] = node.m_left;
+        }
+        return result;
+    }
+
+
+    // Relinks a subtree of the given size into a perfectly balanced one; no node moves within the pool
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare> requires std::movable<Tp>
+    typename compact_search_tree<Tp, Compare>::index_type
+    compact_search_tree<Tp, Compare>::rebuild(const index_type root, const std::size_t size)
+    {
+        auto order { std::vector<index_type>{} };
+        order.reserve(size);
+        flatten(root, order);
+        return relink(order.data(), order.size(), (root == null_index) ? null_index : m_parent[root]);
+    }
+
+
+    // rebuild helper function; lists the nodes of a subtree in order
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare> requires std::movable<Tp>
+    void compact_search_tree<Tp, Compare>::flatten(const index_type root, std::vector<index_type> &order) const
+    {
+        auto s { std::array<index_type, max_depth>{} };
+        auto top = 0;
+        auto curr = root;
+
+        while (curr != null_index || top > 0)
+        {
+            while (curr != null_index)
+            {
+                s[top++] = curr;
+                curr = m_pool[curr].m_left;
+            }
+
+            curr = s[--top];
+            order.push_back(curr);
+            curr = m_pool[curr].m_right;
+        }
+    }
+
+
+    // rebuild helper function; the middle node of each run becomes the subtree root, under the given parent
+    // The result is perfectly balanced, so its runs nest at most 33 deep and each leaves one sibling pending on the stack
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare> requires std::movable<Tp>
+    typename compact_search_tree<Tp, Compare>::index_type
+    compact_search_tree<Tp, Compare>::relink(const index_type *const first, const std::size_t length,
+                                             const index_type parent) noexcept
+    {
+        struct run
+        {
+            std::size_t m_first, m_length;
+            index_type *m_link;
+            index_type m_parent;
+        };
+
+        auto root = null_index;
+        auto s { std::array<run, max_depth>{} };
+        auto top = 0;
+        s[top++] = {0, length, &root, parent};
+
+        while (top > 0)
+        {
+            const auto curr = s[--top];
+            if (curr.m_length == 0)
+            {
+                *curr.m_link = null_index;
+                continue;
+            }
+
+            const auto mid = curr.m_first + curr.m_length / 2;
+            const auto node = first[mid];
+            *curr.m_link = node;
+            m_parent[node] = curr.m_parent;
+
+            s[top++] = {mid + 1, curr.m_length - curr.m_length / 2 - 1, &m_pool[node].m_right, node};
+            s[top++] = {curr.m_first, curr.m_length / 2, &m_pool[node].m_left, node};
+        }
+        return root;
+    }
+
+
+    // for_each helper function; visits a subtree in order
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare> requires std::movable<Tp>
+    template <typename Fn>
+    void compact_search_tree<Tp, Compare>::visit(const index_type root, Fn &fn) const
+    {
+        auto s { std::array<index_type, max_depth>{} };
+        auto top = 0;
+        auto curr = root;
+
+        while (curr != null_index || top > 0)
+        {
+            while (curr != null_index)
+            {
+                s[top++] = curr;
+                curr = m_pool[curr].m_left;
+            }
+
+            curr = s[--top];
+            fn(m_pool[curr].m_value);
+            curr = m_pool[curr].m_right;
+        }
+    }
+
+
+    //************ Non-Member Function Implementations ************//
+
+
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare> requires std::movable<Tp>
+    void swap(compact_search_tree<Tp, Compare> &lhs, compact_search_tree<Tp, Compare> &rhs) noexcept
+    { lhs.swap(rhs); }
+
+}   // namespace nonlinear::tree
+
+
+#endif //DS_GRAPH_COMPACT_SEARCH_TREE_H
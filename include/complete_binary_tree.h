@@ -0,0 +1,352 @@
+#ifndef DS_GRAPH_COMPLETE_BINARY_TREE_H
+#define DS_GRAPH_COMPLETE_BINARY_TREE_H
+
+
+#include <bit>
+#include <concepts>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+
+#include "traits.h"
+
+
+namespace dsl::nonlinear::tree
+{
+    // Array-backed complete binary tree; a node is identified by its level-order index
+    // The root is index 0 and the children of index i are 2i + 1 and 2i + 2
+    template <Comparable Tp>
+    class complete_binary_tree
+    {
+    public:
+
+        //****** Member Functions ******//
+
+        // Constructors
+        complete_binary_tree() noexcept = default;
+        explicit complete_binary_tree(int capacity);
+
+        // Copy constructor
+        complete_binary_tree(const complete_binary_tree&);
+
+        // Move constructor
+        complete_binary_tree(complete_binary_tree &&rhs) noexcept
+            : complete_binary_tree()
+        { swap(rhs); }
+
+        // Pass-by-value copy/move assignment
+        complete_binary_tree& operator=(complete_binary_tree rhs) noexcept
+        { swap(rhs); return *this; }
+
+        ~complete_binary_tree();
+        constexpr void swap(complete_binary_tree &rhs) noexcept;
+
+
+        //****** Access and Traversal ******//
+        [[nodiscard]] constexpr int capacity() const noexcept     { return m_capacity; }
+        [[nodiscard]] constexpr int size() const noexcept         { return m_size; }
+        [[nodiscard]] constexpr bool empty() const noexcept       { return m_size == 0; }
+        [[nodiscard]] constexpr int depth() const noexcept        { return std::bit_width(static_cast<unsigned>(m_size)); }
+
+        [[nodiscard]] static constexpr int parent(const int index) noexcept   { return (index - 1) / 2; }
+        [[nodiscard]] static constexpr int left(const int index) noexcept     { return 2 * index + 1; }
+        [[nodiscard]] static constexpr int right(const int index) noexcept    { return 2 * index + 2; }
+
+        [[nodiscard]] constexpr bool contains_index(const int index) const noexcept
+        { return index >= 0 && index < m_size; }
+
+        [[nodiscard]] constexpr Tp& operator[](const int index) noexcept               { return m_data[index]; }
+        [[nodiscard]] constexpr const Tp& operator[](const int index) const noexcept   { return m_data[index]; }
+        [[nodiscard]] constexpr const Tp& at(int) const;     // throws if index is out of range
+
+        [[nodiscard]] constexpr int last_level_order() const;    // throws if the tree is empty
+        [[nodiscard]] constexpr int find(const Tp&) const noexcept;
+
+        constexpr void in_order(int, std::ostream&) const noexcept;
+        constexpr void post_order(int, std::ostream&) const noexcept;
+        constexpr void pre_order(int, std::ostream&) const noexcept;
+
+        template <Comparable Up>
+        friend std::ostream& operator<<(std::ostream&, const complete_binary_tree<Up>&) noexcept;
+
+
+        //****** Properties ******//
+        [[nodiscard]] constexpr bool is_perfect() const noexcept
+        { return std::has_single_bit(static_cast<unsigned>(m_size) + 1); }
+
+
+        //****** Modifiers ******//
+        constexpr bool push(const Tp&);
+        constexpr bool push(Tp&&);
+        constexpr bool pop(const Tp&);
+
+        template <typename... Args> requires std::constructible_from<Tp, Args...>
+        constexpr bool emplace(Args&&...);
+
+
+    private:
+        int m_capacity = 0, m_size = 0;
+        Tp *m_data = nullptr;     // raw storage; only [0, m_size) holds constructed values
+
+        void reserve(int);
+        [[nodiscard]] constexpr int leftmost(int) const noexcept;
+
+    };  // class complete_binary_tree
+
+
+
+    //************ Member Function Implementations ************//
+
+
+    // Capacity constructor
+    template <Comparable Tp>
+    complete_binary_tree<Tp>::complete_binary_tree(const int capacity)
+    {
+        if (capacity <= 0)
+            throw std::invalid_argument("Failed to initialize for capacity <= 0.");
+        reserve(capacity);
+    }
+
+
+    // Copy constructor
+    template <Comparable Tp>
+    complete_binary_tree<Tp>::complete_binary_tree(const complete_binary_tree<Tp> &rhs)
+    {
+        if (rhs.m_size == 0) return;
+
+        reserve(rhs.m_size);
+        for (; m_size < rhs.m_size; m_size++)
+            ::new (static_cast<void*>(m_data + m_size)) Tp(rhs.m_data[m_size]);
+    }
+
+
+    // Destructor
+    template <Comparable Tp>
+    complete_binary_tree<Tp>::~complete_binary_tree()
+    {
+        for (auto i = 0; i < m_size; i++)
+            m_data[i].~Tp();
+        ::operator delete(m_data);
+        m_data = nullptr;
+    }
+
+
+    // Member swap function
+    template <Comparable Tp>
+    constexpr void complete_binary_tree<Tp>::swap(complete_binary_tree<Tp> &rhs) noexcept
+    {
+        using std::swap;
+        swap(rhs.m_capacity, m_capacity);
+        swap(rhs.m_size, m_size);
+        swap(rhs.m_data, m_data);
+    }
+
+
+    // Grows the storage to hold at least the given number of values
+    template <Comparable Tp>
+    void complete_binary_tree<Tp>::reserve(const int capacity)
+    {
+        if (capacity <= m_capacity) return;
+
+        auto *data = static_cast<Tp*>(::operator new(capacity * sizeof(Tp)));
+        for (auto i = 0; i < m_size; i++)
+        {
+            ::new (static_cast<void*>(data + i)) Tp(std::move_if_noexcept(m_data[i]));
+            m_data[i].~Tp();
+        }
+
+        ::operator delete(m_data);
+        m_data = data;
+        m_capacity = capacity;
+    }
+
+
+    // Returns the value at the given index
+    template <Comparable Tp>
+    constexpr const Tp& complete_binary_tree<Tp>::at(const int index) const
+    {
+        if (!contains_index(index))
+            throw std::out_of_range("Cannot access an index outside the tree.");
+        return m_data[index];
+    }
+
+
+    // Finds the deepest, rightmost node in the tree in O(1)
+    template <Comparable Tp>
+    constexpr int complete_binary_tree<Tp>::last_level_order() const
+    {
+        if (m_size == 0)
+            throw std::out_of_range("Cannot find last node in level order in empty tree.");
+        return m_size - 1;
+    }
+
+
+    // Returns the level-order index of the first node holding the value, or -1 if it does not exist
+    template <Comparable Tp>
+    constexpr int complete_binary_tree<Tp>::find(const Tp &value) const noexcept
+    {
+        for (auto i = 0; i < m_size; i++)
+        {
+            if (m_data[i] == value)
+                return i;
+        }
+        return -1;
+    }
+
+
+    // Returns the leftmost descendant of the given index
+    template <Comparable Tp>
+    constexpr int complete_binary_tree<Tp>::leftmost(int index) const noexcept
+    {
+        while (left(index) < m_size)
+            index = left(index);
+        return index;
+    }
+
+
+    // Writes the subtree to an output stream via in-order traversal; parent links are implicit, so no stack is needed
+    template <Comparable Tp>
+    constexpr void complete_binary_tree<Tp>::in_order(const int index, std::ostream &os) const noexcept
+    {
+        if (!contains_index(index)) return;
+
+        auto curr = leftmost(index);
+        while (true)
+        {
+            os << m_data[curr];
+
+            if (right(curr) < m_size)
+                curr = leftmost(right(curr));
+            else
+            {
+                // Climb while coming up from a right child; the first left-child ancestor is next
+                while (curr != index && curr % 2 == 0)
+                    curr = parent(curr);
+                if (curr == index) return;
+                curr = parent(curr);
+            }
+        }
+    }
+
+
+    // Writes the subtree to an output stream via post-order traversal
+    template <Comparable Tp>
+    constexpr void complete_binary_tree<Tp>::post_order(const int index, std::ostream &os) const noexcept
+    {
+        if (!contains_index(index)) return;
+
+        // Descend to the first node in post-order: prefer left children, fall back to right ones
+        auto first = [this](int i) {
+            while (left(i) < m_size)
+                i = left(i);
+            return i;
+        };
+
+        auto curr = first(index);
+        while (true)
+        {
+            os << m_data[curr];
+            if (curr == index) return;
+
+            const auto up = parent(curr);
+            curr = (curr % 2 == 1 && right(up) < m_size) ? first(right(up)) : up;
+        }
+    }
+
+
+    // Writes the subtree to an output stream via pre-order traversal
+    template <Comparable Tp>
+    constexpr void complete_binary_tree<Tp>::pre_order(const int index, std::ostream &os) const noexcept
+    {
+        if (!contains_index(index)) return;
+
+        auto curr = index;
+        while (true)
+        {
+            os << m_data[curr];
+
+            if (left(curr) < m_size)
+            {
+                curr = left(curr);
+                continue;
+            }
+
+            // Climb to the nearest ancestor whose right subtree has not been visited yet
+            while (curr != index && (curr % 2 == 0 || right(parent(curr)) >= m_size))
+                curr = parent(curr);
+            if (curr == index) return;
+            curr = right(parent(curr));
+        }
+    }
+
+
+    // Overload of operator<< : writes the tree to an output stream in level order
+    template <Comparable Tp>
+    std::ostream& operator<<(std::ostream &os, const complete_binary_tree<Tp> &t) noexcept
+    {
+        for (auto i = 0; i < t.m_size; i++)
+            os << t.m_data[i] << " ";
+        return os;
+    }
+
+
+    // Appends a value at the next level-order position in O(1) amortized
+    template <Comparable Tp>
+    constexpr bool complete_binary_tree<Tp>::push(const Tp &value)
+    { return emplace(value); }
+
+
+    // As push, moving the value into place
+    template <Comparable Tp>
+    constexpr bool complete_binary_tree<Tp>::push(Tp &&value)
+    { return emplace(std::move(value)); }
+
+
+    // Constructs a value from args directly in the slot at the next level-order position
+    template <Comparable Tp>
+    template <typename... Args> requires std::constructible_from<Tp, Args...>
+    constexpr bool complete_binary_tree<Tp>::emplace(Args &&...args)
+    {
+        if (m_size == m_capacity)
+        {
+            // args may refer into the storage about to be reallocated, so the value is built first
+            Tp value(std::forward<Args>(args)...);
+            reserve((m_capacity == 0) ? default_capacity : 2 * m_capacity);
+            ::new (static_cast<void*>(m_data + m_size)) Tp(std::move(value));
+        }
+        else
+            ::new (static_cast<void*>(m_data + m_size)) Tp(std::forward<Args>(args)...);
+
+        m_size++;
+        return true;
+    }
+
+
+    // Removes the first node with the given value, moving the last node in level order into its place
+    template <Comparable Tp>
+    constexpr bool complete_binary_tree<Tp>::pop(const Tp &value)
+    {
+        const auto index = find(value);
+        if (index == -1)
+            return false;
+
+        if (index != m_size - 1)
+            m_data[index] = std::move(m_data[m_size - 1]);
+        m_data[m_size - 1].~Tp();
+        m_size--;
+        return true;
+    }
+
+
+    //************ Non-Member Function Implementations ************//
+
+
+    template <Comparable Tp>
+    constexpr void swap(complete_binary_tree<Tp> &lhs, complete_binary_tree<Tp> &rhs) noexcept
+    { lhs.swap(rhs); }
+
+}   // namespace nonlinear::tree
+
+
+#endif //DS_GRAPH_COMPLETE_BINARY_TREE_H
@@ -2,7 +2,10 @@
 #define DS_GRAPH_DIGRAPH_H
 
 
-#include <optional>
+#include <concepts>
+#include <functional>
+#include <limits>
+#include <ostream>
 #include <queue>
 #include <set>
 #include <stack>
@@ -28,6 +31,10 @@ namespace dsl::nonlinear::graph
                 : m_value(value),
                   m_cost(cost) {}
 
+            constexpr explicit digraph_node(Tp &&value, const int cost = default_weight) noexcept
+                : m_value(std::move(value)),
+                  m_cost(cost) {}
+
             // Copy/move assignment
             constexpr digraph_node& operator=(const digraph_node &rhs) noexcept
             {
@@ -42,6 +49,7 @@ namespace dsl::nonlinear::graph
 
             Tp m_value {};
             int m_cost = default_weight;    //m_cost represents the cost to get to this node
+            digraph_node *m_next = nullptr;     // next edge in the adjacency list this node belongs to
 
         };  // struct digraph_node
 
@@ -59,10 +67,10 @@ namespace dsl::nonlinear::graph
 
         // Constructors
         digraph() noexcept = default;
-        explicit digraph(const int capacity = default_capacity)
+        explicit digraph(const int capacity)
             : m_capacity(capacity),
               m_size(0),
-              m_adjList(m_capacity <= 0 ? nullptr : new digraph_node<Tp>*[m_capacity])
+              m_adjList(m_capacity <= 0 ? nullptr : new digraph_node*[m_capacity]())
         {
             if (m_capacity <= 0)
                 throw std::invalid_argument("Failed to initialize for capacity <= 0.");
@@ -93,30 +101,59 @@ namespace dsl::nonlinear::graph
         [[nodiscard]] constexpr bool contains(const Tp &value) const noexcept
         { return indexOf(value) != -1; }
 
-        constexpr std::optional<const digraph_node&> find_bfs(const Tp&) const noexcept;
-        constexpr std::optional<const digraph_node&> find_dfs(const Tp&) const noexcept;
+        // Searches return the vertex holding the value if it is reachable from the root, otherwise nullptr
+        [[nodiscard]] constexpr const digraph_node* find_bfs(const Tp&) const;
+        [[nodiscard]] constexpr const digraph_node* find_dfs(const Tp&) const;
 
         [[nodiscard]] constexpr bool has_link(const Tp&, const Tp&) const noexcept;
-        [[nodiscard]] constexpr int count_disconnected() const noexcept;
+        [[nodiscard]] constexpr int count_disconnected() const;
         [[nodiscard]] constexpr int in_degree(const Tp&) const noexcept;
         [[nodiscard]] constexpr int out_degree(const Tp&) const noexcept;
 
 
         //****** Modifiers ******//
         constexpr bool try_link(const Tp&, const Tp&) noexcept;
-        constexpr bool push_vertex(const Tp&, int = default_weight) noexcept;
-        constexpr bool push_edge(const Tp&, const Tp&, int = default_weight, int = default_weight) noexcept;
+        constexpr bool push_vertex(const Tp &value, const int weight = details::default_weight) noexcept
+        { return insert_vertex(value, weight); }
+
+        constexpr bool push_vertex(Tp &&value, const int weight = details::default_weight) noexcept
+        { return insert_vertex(std::move(value), weight); }
+
+        // Builds the value from args once and moves it into a new vertex of default weight
+        template <typename... Args> requires std::constructible_from<Tp, Args...>
+        constexpr bool emplace_vertex(Args &&...args)
+        { return insert_vertex(Tp(std::forward<Args>(args)...), details::default_weight); }
+
+        constexpr bool push_edge(const Tp &start, const Tp &end,
+                                 const int start_weight = details::default_weight,
+                                 const int end_weight = details::default_weight) noexcept
+        { return insert_edge(start, end, start_weight, end_weight); }
+
+        constexpr bool push_edge(Tp &&start, Tp &&end,
+                                 const int start_weight = details::default_weight,
+                                 const int end_weight = details::default_weight) noexcept
+        { return insert_edge(std::move(start), std::move(end), start_weight, end_weight); }
+
         constexpr bool pop_vertex(const Tp&) noexcept;
 
-        friend std::ostream& operator<<(std::ostream&, const digraph<Tp>&) noexcept;
+        template <Comparable Up>
+        friend std::ostream& operator<<(std::ostream&, const digraph<Up>&);
 
     private:
         int m_capacity = 0, m_size = 0;
-        digraph_node<Tp> **m_adjList;
+        digraph_node **m_adjList = nullptr;
 
 
+        [[nodiscard]] constexpr int root() const noexcept;
         constexpr int indexOf(const Tp&) const noexcept;
-        constexpr int try_push(const Tp&, int = default_weight) noexcept;
+        constexpr bool try_link(digraph_node*, const Tp&) noexcept;
+
+        template <typename Vp>
+        constexpr int try_push(Vp&&, int = details::default_weight) noexcept;
+        template <typename Vp>
+        constexpr bool insert_vertex(Vp&&, int) noexcept;
+        template <typename Sp, typename Ep>
+        constexpr bool insert_edge(Sp&&, Ep&&, int, int) noexcept;
 
     };  // class digraph
 
@@ -129,7 +166,7 @@ namespace dsl::nonlinear::graph
     digraph<Tp>::digraph(const digraph<Tp> &rhs)
         : m_capacity(rhs.m_capacity),
           m_size(rhs.m_size),
-          m_adjList(rhs.m_capcacity <= 0 ? nullptr : new digraph_node<Tp>*[rhs.m_capacity])
+          m_adjList(rhs.m_capacity <= 0 ? nullptr : new digraph_node*[rhs.m_capacity]())
     {
         if (m_adjList != nullptr)
         {
@@ -138,13 +175,13 @@ namespace dsl::nonlinear::graph
                 if (rhs.m_adjList[i] != nullptr)
                 {
                     auto *rhs_curr = rhs.m_adjList[i];
-                    m_adjList[i] = new digraph_node<Tp>(rhs_curr->m_value);
+                    m_adjList[i] = new digraph_node(rhs_curr->m_value, rhs_curr->m_cost);
                     auto *lhs_curr = m_adjList[i];
                     rhs_curr = rhs_curr->m_next;
 
                     while (rhs_curr != nullptr)
                     {
-                        lhs_curr->m_next = new digraph_node<Tp>(rhs_curr->m_value);
+                        lhs_curr->m_next = new digraph_node(rhs_curr->m_value, rhs_curr->m_cost);
                         lhs_curr = lhs_curr->m_next;
                         rhs_curr = rhs_curr->m_next;
                     }
@@ -161,9 +198,9 @@ namespace dsl::nonlinear::graph
     template <Comparable Tp>
     digraph<Tp>::~digraph()
     {
-        for (const auto &node : m_adjList)
+        for (auto i = 0; i < m_capacity; i++)
         {
-            auto *curr = node;
+            auto *curr = m_adjList[i];
             while (curr != nullptr)
             {
                 auto *temp = curr->m_next;
@@ -188,185 +225,163 @@ namespace dsl::nonlinear::graph
     }
 
 
+    // Breadth-first search from the root, following the edges in each adjacency list
     template <Comparable Tp>
-    constexpr std::optional<const typename digraph<Tp>::digraph_node&>
-    digraph<Tp>::find_bfs(const Tp &value) const noexcept
+    constexpr const typename digraph<Tp>::digraph_node*
+    digraph<Tp>::find_bfs(const Tp &value) const
     {
-        digraph_node *curr = nullptr;
-        for (auto i = 0; i < m_capacity; i++)
-        {
-            if (m_adjList[i] == nullptr)
-                continue;
-            curr = m_adjList[i];
-            break;
-        }
-
-        if (curr != nullptr)
+        const auto start = root();
+        if (start != -1)
         {
-            auto visited { std::set<digraph_node *const>{} };
-            auto q { std::queue<digraph_node *const>{} };
-            q.push(curr);
+            auto visited { std::set<int>{} };
+            auto q { std::queue<int>{} };
+            q.push(start);
 
             while (!q.empty())
             {
-                auto *qf = q.front();
+                auto qf = q.front();
                 q.pop();
 
-                if (qf->m_value == value)
-                    return *qf;
+                if (m_adjList[qf]->m_value == value)
+                    return m_adjList[qf];
 
                 if (visited.find(qf) != visited.end())
                     continue;
 
-                visited.insert(*qf);
-                auto *it = qf;
-                while (it != nullptr)
-                {
-                    q.push(it);
-                    it = it->m_next;
-                }
+                visited.insert(qf);
+                for (auto *it = m_adjList[qf]->m_next; it != nullptr; it = it->m_next)
+                    q.push(indexOf(it->m_value));
             }
         }
-        return std::nullopt;
+        return nullptr;
     }
 
 
+    // Depth-first search from the root, following the edges in each adjacency list
     template <Comparable Tp>
-    constexpr std::optional<const digraph_node&>
-    digraph<Tp>::find_dfs(const Tp &value) const noexcept
+    constexpr const typename digraph<Tp>::digraph_node*
+    digraph<Tp>::find_dfs(const Tp &value) const
     {
-        digraph_node *curr = nullptr;
-        for (auto i = 0; i < m_capacity; i++)
+        const auto start = root();
+        if (start != -1)
         {
-            if (m_adjList[i] == nullptr)
-                continue;
-            curr = m_adjList[i];
-            break;
-        }
-
-        auto *curr = m_root;
-        if (m_root != nullptr)
-        {
-            auto visited { std::set<digraph_node *const>{} };
-            auto s { std::stack<digraph_node *const>{} };
-            s.push(curr);
+            auto visited { std::set<int>{} };
+            auto s { std::stack<int>{} };
+            s.push(start);
 
             while (!s.empty())
             {
-                auto *st = s.top();
+                auto st = s.top();
                 s.pop();
 
-                if (st->m_value == value)
-                    return *st;
+                if (m_adjList[st]->m_value == value)
+                    return m_adjList[st];
 
                 if (visited.find(st) != visited.end())
                     continue;
                 visited.insert(st);
 
-                auto *it = st;
-                while (it != nullptr)
-                {
-                    s.push(it);
-                    it = it->m_next;
-                }
+                for (auto *it = m_adjList[st]->m_next; it != nullptr; it = it->m_next)
+                    s.push(indexOf(it->m_value));
             }
         }
-        return std::nullopt;
+        return nullptr;
     }
 
 
     template <Comparable Tp>
     constexpr bool digraph<Tp>::has_link(const Tp &start, const Tp &end) const noexcept
     {
-        for (const auto &node : m_adjList)
+        const auto i = indexOf(start);
+        if (i == -1)
+            return false;
+
+        for (auto *curr = m_adjList[i]->m_next; curr != nullptr; curr = curr->m_next)
         {
-            if (node != nullptr && node->m_value == start)
-            {
-                auto *curr = node;
-                while (curr != nullptr)
-                {
-                    if (curr->m_value == end)
-                        return true;
-                    curr = curr->m_next;
-                }
-            }
+            if (curr->m_value == end)
+                return true;
         }
         return false;
     }
 
 
+    // Counts the vertices that cannot be reached from the root
     template <Comparable Tp>
-    constexpr int digraph<Tp>::count_disconnected() const noexcept
+    constexpr int digraph<Tp>::count_disconnected() const
     {
         auto count = 0;
-        if (m_root != nullptr)
+        const auto start = root();
+        if (start != -1)
         {
-            auto visited { std::set<digraph_node *const>{} };
-            auto q { std::queue<digraph_node *const>{} };
-            q.push(m_root);
+            auto visited { std::set<int>{} };
+            auto q { std::queue<int>{} };
+            q.push(start);
             while (!q.empty())
             {
-                auto *qf = q.front();
+                auto qf = q.front();
                 q.pop();
-                count++;
 
                 if (visited.find(qf) != visited.end())
                     continue;
                 visited.insert(qf);
+                count++;
 
-                auto *it = qf;
-                while (it != nullptr)
-                {
-                    q.push(it);
-                    it = it->m_next;
-                }
+                for (auto *it = m_adjList[qf]->m_next; it != nullptr; it = it->m_next)
+                    q.push(indexOf(it->m_value));
             }
         }
         return m_size - count;
     }
 
 
+    // Counts the edges into the vertex holding value
     template <Comparable Tp>
     constexpr int digraph<Tp>::in_degree(const Tp &value) const noexcept
     {
-        digraph_node<Tp> *curr = nullptr;
-        for (const auto &node : m_adjList)
+        auto count = 0;
+        for (auto i = 0; i < m_capacity; i++)
         {
-            if (node != nullptr && node.m_value != value)
+            if (m_adjList[i] == nullptr)
                 continue;
-            curr = node;
-            break;
-        }
 
-        auto count = 0;
-        while (node != nullptr)
-        {
-            ++count;
-            node = node->m_next;
+            for (auto *curr = m_adjList[i]->m_next; curr != nullptr; curr = curr->m_next)
+            {
+                if (curr->m_value == value)
+                {
+                    ++count;
+                    break;
+                }
+            }
         }
-
         return count;
     }
 
 
+    // Counts the edges out of the vertex holding value
     template <Comparable Tp>
     constexpr int digraph<Tp>::out_degree(const Tp &value) const noexcept
     {
+        const auto i = indexOf(value);
+        if (i == -1)
+            return 0;
+
         auto count = 0;
-        for (const auto &node : m_adjList)
+        for (auto *curr = m_adjList[i]->m_next; curr != nullptr; curr = curr->m_next)
+            ++count;
+        return count;
+    }
+
+
+    // Private helper function; gets the index of the root, the first vertex in the adjacency list, if there is one
+    template <Comparable Tp>
+    constexpr int digraph<Tp>::root() const noexcept
+    {
+        for (auto i = 0; i < m_capacity; i++)
         {
-            auto *curr = node;
-            while (curr != nullptr)
-            {
-                if (curr->m_value == value)
-                {
-                    ++count;
-                    break;
-                }
-                curr = curr->m_next;
-            }
+            if (m_adjList[i] != nullptr)
+                return i;
         }
-        return count;
+        return -1;
     }
 
 
@@ -374,64 +389,65 @@ namespace dsl::nonlinear::graph
     template <Comparable Tp>
     constexpr int digraph<Tp>::indexOf(const Tp &value) const noexcept
     {
-        for (const auto &node : m_adjList)
+        for (auto i = 0; i < m_capacity; i++)
         {
-            if (node != nullptr && node->m_value == value)
+            if (m_adjList[i] != nullptr && m_adjList[i]->m_value == value)
                 return i;
         }
         return -1;
     }
 
 
+    // Adds an edge from lhs to rhs, if both are vertices and the edge is not there yet
     template <Comparable Tp>
     constexpr bool digraph<Tp>::try_link(const Tp &lhs, const Tp &rhs) noexcept
     {
-        auto i = indexOf(lhs);
-        auto *curr = (i != -1) ? m_adjList[i] : nullptr;
-        if (curr != nullptr)
-        {
-            digraph_node<Tp> *prev = nullptr;
-            while (curr != nullptr)
-            {
-                prev = curr;
-                curr = curr->m_next;
-            }
-            prev->m_next = m_adjList[indexOf(rhs)];
-            return true;
-        }
-        return false;
+        const auto i = indexOf(lhs);
+        return (i != -1) && try_link(m_adjList[i], rhs);
     }
 
 
-    // Pushes a weighted node into the graph. Does not establish connectivity.
+    // try_link helper function; appends an edge to rhs, carrying its cost, to the adjacency list headed by node
     template <Comparable Tp>
-    constexpr bool digraph<Tp>::push_vertex(const Tp &value, const int weight) noexcept
+    constexpr bool digraph<Tp>::try_link(digraph_node *const node, const Tp &rhs) noexcept
     {
-        if (full() || contains(value)) return false;
-        for (auto i = 0; i < m_capacity; i++)
+        const auto j = indexOf(rhs);
+        if (node == nullptr || j == -1)
+            return false;
+
+        auto *prev = node;
+        for (auto *curr = node->m_next; curr != nullptr; curr = curr->m_next)
         {
-            if (m_adjList[i] == nullptr)
-            {
-                m_adjList[i] = new digraph_node<Tp>(value, weight);
-                return true;
-            }
+            if (curr->m_value == rhs)
+                return false;
+            prev = curr;
         }
-        return false;
+
+        prev->m_next = new digraph_node(m_adjList[j]->m_value, m_adjList[j]->m_cost);
+        return true;
     }
 
 
-    // push_edge helper function
+    // Pushes a weighted node into the graph. Does not establish connectivity.
+    // The value is forwarded into the node, so push_vertex(Tp&&) moves rather than copies it
+    template <Comparable Tp>
+    template <typename Vp>
+    constexpr bool digraph<Tp>::insert_vertex(Vp &&value, const int weight) noexcept
+    { return try_push(std::forward<Vp>(value), weight) != -1; }
+
+
+    // push_edge helper function; returns the index of the new vertex, or -1 if the value is already there
     template <Comparable Tp>
-    constexpr int digraph<Tp>::try_push(const Tp &value, const int weight) noexcept
+    template <typename Vp>
+    constexpr int digraph<Tp>::try_push(Vp &&value, const int weight) noexcept
     {
+        if (full() || contains(value)) return -1;
         for (auto i = 0; i < m_capacity; i++)
         {
-            if (m_adjList[i] != nullptr && m_adjList[i]->m_value == value)
-                break;
-
             if (m_adjList[i] == nullptr)
             {
-                m_adjList[i] = new digraph_node<Tp>(value, weight);
+                m_adjList[i] = new digraph_node(std::forward<Vp>(value), weight);
+                m_size++;
                 return i;
             }
         }
@@ -440,11 +456,13 @@ namespace dsl::nonlinear::graph
 
 
     // Pushes a weighted edge into the graph.
+    // A value is forwarded into its new node at most once; afterwards the copy stored in the node is used
     template <Comparable Tp>
-    constexpr bool digraph<Tp>::push_edge(const Tp &start,
-                                          const Tp &end,
-                                          const int start_weight = details::default_weight,
-                                          const int end_weight = details::default_weight) noexcept
+    template <typename Sp, typename Ep>
+    constexpr bool digraph<Tp>::insert_edge(Sp &&start,
+                                            Ep &&end,
+                                            const int start_weight,
+                                            const int end_weight) noexcept
     {
         // if contains start, link to end. add end to adjacency list, point to start, disregard(?) or overwrite weight.
         // if contains end, link to start. add start to adjacency list, point to end, disregard(?) or overwrite weight.
@@ -464,6 +482,7 @@ namespace dsl::nonlinear::graph
             {
                 try_link(m_adjList[indexOf(start)], end);
                 try_link(m_adjList[indexOf(end)], start);
+                return true;
             }
 
             // One is contained only or double containment fails link condition
@@ -471,15 +490,16 @@ namespace dsl::nonlinear::graph
             {
                 if (m_capacity - m_size < 1) return false;  // cannot push, leads to overflow
 
-                auto nvalue = (has_start) ? end : start;
-                auto nweight = (has_start) ? end_weight : start_weight;
-
-                int index = try_push(nvalue, nweight);
+                // Only the value not yet in the graph is consumed; the new one is read back from its node
+                int index = (has_start) ? try_push(std::forward<Ep>(end), end_weight)
+                                        : try_push(std::forward<Sp>(start), start_weight);
                 if (index != -1)
                 {
-                    try_link(m_adjList[index], (has_start) ? start : end);
-                    try_link(m_adjList[indexOf((has_start) ? end : start)], (has_start) ? start : end);
+                    const auto &existing = (has_start) ? start : end;
+                    try_link(m_adjList[index], existing);
+                    try_link(m_adjList[indexOf(m_adjList[index]->m_value)], existing);
                 }
+                return index != -1;
             }
         }
 
@@ -487,49 +507,45 @@ namespace dsl::nonlinear::graph
         else
         {
             if (m_capacity - m_size < 2) return false;  // cannot push, leads to overflow
-            auto s_index = try_push(start, start_weight), e_index = try_push(end, end_weight);
-            try_link(m_adjList[s_index], end);
-            try_link(m_adjList[e_index], start);
+            auto s_index = try_push(std::forward<Sp>(start), start_weight), e_index = try_push(std::forward<Ep>(end), end_weight);
+            try_link(m_adjList[s_index], m_adjList[e_index]->m_value);
+            try_link(m_adjList[e_index], m_adjList[s_index]->m_value);
+            return true;
         }
     }
 
 
-    // Traversal operates on Dijkstra's algorithm
+    // Traversal operates on Dijkstra's algorithm: writes the vertices reachable from the root in the order they are
+    // settled, where following an edge costs the m_cost of the vertex it leads to
     template <Comparable Tp>
-    std::ostream& operator<<(std::ostream &os, const digraph<Tp> &graph) noexcept
+    std::ostream& operator<<(std::ostream &os, const digraph<Tp> &graph)
     {
-        using digraph_node = typename digraph<Tp>::digraph_node;
+        const auto start = graph.root();
+        if (start == -1)
+            return os;
 
-        auto s    { std::set<digraph_node *const>{} };
-        auto dist { std::map<digraph_node*, int>{} };
-        auto prev { std::vector<digraph_node *const>{} };
-
-        for (auto i = 0; i < graph.capacity(); i++)
-        {
-            if (graph.m_adjList[i] != nullptr)
-            {
-                dist[i].first = graph.m_adjList[i];
-                s.insert(node);
-                dist.insert(std::make_pair<digraph_node*, int>(graph.m_adjList[i], std::numeric_limits<int>::max()));
-            }
-        }
-        dist[0].second = 0;
+        auto dist    { std::vector<int>(graph.m_capacity, std::numeric_limits<int>::max()) };
+        auto settled { std::vector<bool>(graph.m_capacity, false) };
+        auto q       { std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>>{} };
 
-        while (!s.empty())
+        dist[start] = 0;
+        q.emplace(0, start);
+        while (!q.empty())
         {
-            auto min = *std::min_element(s.begin(), s.end(),
-                          [](decltype(dist)::value_type &l, decltype(dist)::value_type &r) -> bool { return l.second < r.second; } );
-            s.erase(min.first);
+            const auto [cost, i] = q.top();
+            q.pop();
+            if (settled[i])
+                continue;
+            settled[i] = true;
 
-            os << min.first->m_value;
-            auto *curr = min.first->m_next;
-            while (curr != nullptr)
+            os << graph.m_adjList[i]->m_value << " ";
+            for (auto *curr = graph.m_adjList[i]->m_next; curr != nullptr; curr = curr->m_next)
             {
-                auto temp = dist[min.first] + curr->m_cost;
-                if (temp < dist[curr])
+                const auto j = graph.indexOf(curr->m_value);
+                if (!settled[j] && cost + curr->m_cost < dist[j])
                 {
-                    dist[curr] = temp;
-                    prev.push_back(min.first);
+                    dist[j] = cost + curr->m_cost;
+                    q.emplace(dist[j], j);
                 }
             }
         }
@@ -537,30 +553,43 @@ namespace dsl::nonlinear::graph
     }
 
 
+    // Removes the vertex holding value, along with every edge into or out of it
     template <Comparable Tp>
     constexpr bool digraph<Tp>::pop_vertex(const Tp &value) noexcept
     {
+        const auto index = indexOf(value);
+        if (index == -1)
+            return false;
+
         // invalidate all linked list m_next pointers first
-        // delete from the pointer C-style array
         for (auto i = 0; i < m_capacity; i++)
         {
-            digraph_node *curr = m_adjList[i];
-            if (m_adjList[i] != nullptr)
+            if (i == index || m_adjList[i] == nullptr)
+                continue;
+
+            for (auto *prev = m_adjList[i]; prev->m_next != nullptr; prev = prev->m_next)
             {
-                digraph_node *prev = nullptr, *curr = m_adjList[i];
-                while (curr != nullptr)
+                if (prev->m_next->m_value == value)
                 {
-                    if (curr->m_value == value)
-                    {
-                        auto *temp = curr->m_next;
-                        if (prev != nullptr)
-                            prev->m_next = temp;
-                    }
+                    auto *temp = prev->m_next;
+                    prev->m_next = temp->m_next;
+                    delete temp;
+                    break;
                 }
             }
+        }
+
+        // delete from the pointer C-style array
+        auto *curr = m_adjList[index];
+        while (curr != nullptr)
+        {
+            auto *temp = curr->m_next;
             delete curr;
-            curr = nullptr;
+            curr = temp;
         }
+        m_adjList[index] = nullptr;
+        m_size--;
+        return true;
     }
 
 
@@ -0,0 +1,238 @@
+#ifndef DS_GRAPH_EPOCH_H
+#define DS_GRAPH_EPOCH_H
+
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+
+namespace dsl::nonlinear
+{
+    namespace details
+    {
+        struct retired
+        {
+            void *m_ptr;
+            void (*m_deleter)(void*);
+        };
+
+
+        // Per-thread reclamation state; records are recycled when their thread exits, never freed
+        struct epoch_record
+        {
+            std::atomic<std::uint64_t> m_state {0};     // (epoch << 1) | pinned
+            std::atomic<bool> m_owned {false};
+            epoch_record *m_next = nullptr;
+
+            // Touched only by the owning thread
+            int m_depth = 0;
+            int m_retires = 0;
+            std::uint64_t m_seen = 0;
+            std::uint64_t m_labels[3] {};
+            std::vector<retired> m_limbo[3];            // nodes retired in epoch m_labels[i], i == epoch % 3
+
+        };  // struct epoch_record
+
+    }   // namespace details
+
+
+
+    // Epoch-based memory reclamation for lock-free containers
+    // Readers pin the current epoch for the duration of an operation; a node unlinked in epoch e is retired and
+    // freed once the global epoch reaches e + 2, when no thread pinned early enough to have seen it can remain
+    class epoch_domain
+    {
+    public:
+        // Keeps the calling thread pinned while alive; guards nest
+        class guard
+        {
+        public:
+            explicit guard(epoch_domain &domain)
+                : m_domain(domain)
+            { m_domain.enter(); }
+
+            guard(const guard&) = delete;
+            guard& operator=(const guard&) = delete;
+
+            ~guard()    { m_domain.leave(); }
+
+        private:
+            epoch_domain &m_domain;
+
+        };  // class guard
+
+
+        //****** Member Functions ******//
+
+        epoch_domain(const epoch_domain&) = delete;
+        epoch_domain& operator=(const epoch_domain&) = delete;
+
+        // Process-wide domain shared by the concurrent containers; intentionally never destroyed
+        [[nodiscard]] static epoch_domain& shared()
+        {
+            static auto *domain = new epoch_domain();
+            return *domain;
+        }
+
+        [[nodiscard]] guard pin()   { return guard(*this); }
+
+        // Hands an unlinked node to the domain; must be called while pinned
+        template <typename Tp>
+        void retire(Tp *ptr)
+        { retire(ptr, [](void *p) { delete static_cast<Tp*>(p); }); }
+
+        void retire(void*, void (*)(void*));
+
+
+    private:
+        // Retires between attempts to advance the global epoch
+        static constexpr const int advance_interval = 64;
+
+        std::atomic<std::uint64_t> m_epoch {0};
+        std::atomic<details::epoch_record*> m_records {nullptr};
+
+        epoch_domain() noexcept = default;
+
+        [[nodiscard]] details::epoch_record& record();
+        void enter();
+        void leave() noexcept;
+        void try_advance() noexcept;
+        static void collect(details::epoch_record&, std::uint64_t) noexcept;
+        static void free_bucket(details::epoch_record&, int) noexcept;
+
+    };  // class epoch_domain
+
+
+
+    //************ Member Function Implementations ************//
+
+
+    // Returns the calling thread's record, claiming a free one (or allocating a new one) on first use
+    inline details::epoch_record& epoch_domain::record()
+    {
+        // Releases the record when the thread exits; its unreclaimed nodes pass to the next owner
+        struct slot
+        {
+            details::epoch_record *m_record = nullptr;
+            ~slot()
+            {
+                if (m_record != nullptr)
+                    m_record->m_owned.store(false, std::memory_order_release);
+            }
+        };
+        static thread_local slot t_slot;
+
+        if (t_slot.m_record != nullptr)
+            return *t_slot.m_record;
+
+        for (auto *curr = m_records.load(std::memory_order_acquire); curr != nullptr; curr = curr->m_next)
+        {
+            auto owned = false;
+            if (curr->m_owned.compare_exchange_strong(owned, true, std::memory_order_acquire))
+            {
+                t_slot.m_record = curr;
+                return *curr;
+            }
+        }
+
+        auto *created = new details::epoch_record();
+        created->m_owned.store(true, std::memory_order_relaxed);
+        created->m_next = m_records.load(std::memory_order_relaxed);
+        while (!m_records.compare_exchange_weak(created->m_next, created, std::memory_order_release, std::memory_order_relaxed)) {}
+
+        t_slot.m_record = created;
+        return *created;
+    }
+
+
+    // Pins the thread to the current epoch, reclaiming whatever the epoch it observes has made safe
+    inline void epoch_domain::enter()
+    {
+        auto &rec = record();
+        if (rec.m_depth++ > 0)
+            return;
+
+        // Acquire: the frees below must happen after every read made by threads unpinned since that epoch began
+        const auto epoch = m_epoch.load(std::memory_order_acquire);
+        rec.m_state.store((epoch << 1) | 1u, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (epoch != rec.m_seen)
+            collect(rec, epoch);
+    }
+
+
+    // Unpins the thread once its outermost guard ends
+    inline void epoch_domain::leave() noexcept
+    {
+        auto &rec = record();
+        if (--rec.m_depth > 0)
+            return;
+
+        rec.m_state.store(rec.m_state.load(std::memory_order_relaxed) & ~std::uint64_t{1}, std::memory_order_release);
+    }
+
+
+    // Labels the node with the global epoch current after its unlinking, not the (possibly older) pinned one
+    inline void epoch_domain::retire(void *const ptr, void (*const deleter)(void*))
+    {
+        auto &rec = record();
+        const auto epoch = m_epoch.load(std::memory_order_seq_cst);
+        const auto bucket = static_cast<int>(epoch % 3);
+
+        if (rec.m_labels[bucket] != epoch)
+        {
+            // Anything still here is at least three epochs old
+            free_bucket(rec, bucket);
+            rec.m_labels[bucket] = epoch;
+        }
+        rec.m_limbo[bucket].push_back({ptr, deleter});
+
+        if (++rec.m_retires % advance_interval == 0)
+            try_advance();
+    }
+
+
+    // Moves the global epoch forward if every pinned thread has observed it
+    inline void epoch_domain::try_advance() noexcept
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto epoch = m_epoch.load(std::memory_order_relaxed);
+
+        for (auto *curr = m_records.load(std::memory_order_acquire); curr != nullptr; curr = curr->m_next)
+        {
+            const auto state = curr->m_state.load(std::memory_order_acquire);
+            if ((state & 1u) && (state >> 1) != epoch)
+                return;
+        }
+
+        if (m_epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst))
+            collect(record(), epoch + 1);
+    }
+
+
+    // Frees the thread's nodes retired two or more epochs before the observed one
+    inline void epoch_domain::collect(details::epoch_record &rec, const std::uint64_t epoch) noexcept
+    {
+        rec.m_seen = epoch;
+        for (auto bucket = 0; bucket < 3; bucket++)
+        {
+            if (rec.m_labels[bucket] + 2 <= epoch)
+                free_bucket(rec, bucket);
+        }
+    }
+
+
+    // Runs the deleters of one limbo bucket
+    inline void epoch_domain::free_bucket(details::epoch_record &rec, const int bucket) noexcept
+    {
+        for (const auto &node : rec.m_limbo[bucket])
+            node.m_deleter(node.m_ptr);
+        rec.m_limbo[bucket].clear();
+    }
+
+}   // namespace nonlinear
+
+
+#endif //DS_GRAPH_EPOCH_H
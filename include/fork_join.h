@@ -0,0 +1,248 @@
+#ifndef DS_GRAPH_FORK_JOIN_H
+#define DS_GRAPH_FORK_JOIN_H
+
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace dsl::nonlinear
+{
+    // Subtrees estimated to hold fewer nodes than this are processed sequentially by parallel tree operations
+    static constexpr const int default_parallel_cutoff = 1 << 14;
+
+
+    namespace details
+    {
+        // A forked half of fork_join_pool::invoke; it lives in the forking frame, and whoever dequeues it runs it
+        struct fork_task
+        {
+            void (*m_run)(void*) = nullptr;
+            void *m_arg = nullptr;
+            std::exception_ptr m_error;
+            std::atomic<bool> m_done {false};
+
+            void operator()() noexcept
+            {
+                try { m_run(m_arg); }
+                catch (...) { m_error = std::current_exception(); }
+                m_done.store(true, std::memory_order_release);
+            }
+
+        };  // struct fork_task
+
+    }   // namespace details
+
+
+
+    // Work-stealing pool for fork-join parallelism; a thread waiting on a join runs queued work instead of blocking
+    class fork_join_pool
+    {
+    public:
+
+        //****** Member Functions ******//
+
+        explicit fork_join_pool(unsigned = std::max(1u, std::thread::hardware_concurrency()));
+
+        fork_join_pool(const fork_join_pool&) = delete;
+        fork_join_pool& operator=(const fork_join_pool&) = delete;
+
+        ~fork_join_pool();
+
+        // Process-wide pool shared by the tree containers; intentionally never destroyed
+        [[nodiscard]] static fork_join_pool& shared()
+        {
+            static auto *pool = new fork_join_pool();
+            return *pool;
+        }
+
+        [[nodiscard]] int workers() const noexcept      { return m_count; }
+
+
+        //****** Fork-Join ******//
+        // Runs both callables, possibly concurrently, and returns once both have finished
+        template <std::invocable F, std::invocable G>
+        void invoke(F&&, G&&);
+
+
+    private:
+        struct task_queue
+        {
+            std::mutex m_mutex;
+            std::deque<details::fork_task*> m_tasks;
+        };
+
+        int m_count;
+        std::unique_ptr<task_queue[]> m_queues;     // one per worker, plus one shared by outside threads
+        std::vector<std::thread> m_threads;
+
+        std::atomic<int> m_pending {0};
+        std::atomic<bool> m_stop {false};
+        std::mutex m_idle_mutex;
+        std::condition_variable m_idle;
+
+        inline static thread_local const fork_join_pool *t_pool = nullptr;
+        inline static thread_local int t_index = -1;
+
+        [[nodiscard]] int self() const noexcept     { return (t_pool == this) ? t_index : m_count; }
+
+        void push(int, details::fork_task*);
+        details::fork_task* pop(int) noexcept;
+        details::fork_task* steal(int) noexcept;
+        void run(int) noexcept;
+
+    };  // class fork_join_pool
+
+
+
+    //************ Member Function Implementations ************//
+
+
+    // Starts the worker threads
+    inline fork_join_pool::fork_join_pool(const unsigned threads)
+        : m_count(static_cast<int>(std::max(1u, threads))),
+          m_queues(std::make_unique<task_queue[]>(m_count + 1))
+    {
+        m_threads.reserve(m_count);
+        for (auto i = 0; i < m_count; i++)
+            m_threads.emplace_back([this, i] { run(i); });
+    }
+
+
+    // Stops and joins the worker threads
+    inline fork_join_pool::~fork_join_pool()
+    {
+        {
+            auto lock = std::lock_guard{m_idle_mutex};
+            m_stop.store(true);
+        }
+        m_idle.notify_all();
+
+        for (auto &thread : m_threads)
+            thread.join();
+    }
+
+
+    // Queues a task on the given queue and wakes an idle worker
+    inline void fork_join_pool::push(const int index, details::fork_task *const task)
+    {
+        {
+            auto lock = std::lock_guard{m_queues[index].m_mutex};
+            m_queues[index].m_tasks.push_back(task);
+        }
+
+        m_pending.fetch_add(1);
+        {
+            auto lock = std::lock_guard{m_idle_mutex};
+        }
+        m_idle.notify_one();
+    }
+
+
+    // Takes the most recently queued task from the thread's own queue
+    inline details::fork_task* fork_join_pool::pop(const int index) noexcept
+    {
+        auto lock = std::lock_guard{m_queues[index].m_mutex};
+        auto &tasks = m_queues[index].m_tasks;
+        if (tasks.empty())
+            return nullptr;
+
+        auto *task = tasks.back();
+        tasks.pop_back();
+        m_pending.fetch_sub(1);
+        return task;
+    }
+
+
+    // Takes the oldest (largest) task from some other queue
+    inline details::fork_task* fork_join_pool::steal(const int index) noexcept
+    {
+        for (auto i = 1; i <= m_count; i++)
+        {
+            auto &queue = m_queues[(index + i) % (m_count + 1)];
+            auto lock = std::lock_guard{queue.m_mutex};
+            if (queue.m_tasks.empty())
+                continue;
+
+            auto *task = queue.m_tasks.front();
+            queue.m_tasks.pop_front();
+            m_pending.fetch_sub(1);
+            return task;
+        }
+        return nullptr;
+    }
+
+
+    // Worker loop; sleeps only while no queue holds a task
+    inline void fork_join_pool::run(const int index) noexcept
+    {
+        t_pool = this;
+        t_index = index;
+
+        while (true)
+        {
+            auto *task = pop(index);
+            if (task == nullptr)
+                task = steal(index);
+
+            if (task != nullptr)
+            {
+                (*task)();
+                continue;
+            }
+
+            auto lock = std::unique_lock{m_idle_mutex};
+            m_idle.wait(lock, [this] { return m_stop.load() || m_pending.load() > 0; });
+            if (m_stop.load() && m_pending.load() == 0)
+                return;
+        }
+    }
+
+
+    // Forks g onto the caller's queue, runs f inline, then helps with queued work until g has finished
+    template <std::invocable F, std::invocable G>
+    void fork_join_pool::invoke(F &&f, G &&g)
+    {
+        auto forked = [&g] { std::invoke(g); };
+        auto task = details::fork_task{};
+        task.m_run = [](void *arg) { (*static_cast<decltype(forked)*>(arg))(); };
+        task.m_arg = &forked;
+
+        const auto index = self();
+        push(index, &task);
+
+        auto error = std::exception_ptr{};
+        try { std::invoke(f); }
+        catch (...) { error = std::current_exception(); }
+
+        while (!task.m_done.load(std::memory_order_acquire))
+        {
+            auto *next = pop(index);
+            if (next == nullptr)
+                next = steal(index);
+
+            if (next != nullptr)
+                (*next)();
+            else
+                std::this_thread::yield();
+        }
+
+        if (error)
+            std::rethrow_exception(error);
+        if (task.m_error)
+            std::rethrow_exception(task.m_error);
+    }
+
+}   // namespace nonlinear
+
+
+#endif //DS_GRAPH_FORK_JOIN_H
@@ -0,0 +1,235 @@
+#ifndef DS_GRAPH_HASH_CONS_FACTORY_H
+#define DS_GRAPH_HASH_CONS_FACTORY_H
+
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "bitree_node.h"
+
+
+namespace dsl::nonlinear::tree
+{
+    // Node factory that interns immutable subtrees: a (value, left, right) triple is allocated at most once,
+    // so identical subtrees share storage and two interned subtrees are equal iff they are the same pointer
+    // The factory owns every node it returns; nodes live until collected or until the factory is destroyed
+    template <Comparable Tp> requires Hashable<Tp>
+    class hash_cons_factory
+    {
+    public:
+        using bitree_node = typename details::bitree_node<Tp>;
+
+
+        //****** Member Functions ******//
+
+        // No-throw constructor
+        hash_cons_factory() noexcept = default;
+
+        // Interned nodes are shared by identity, so the factory is move-only
+        hash_cons_factory(const hash_cons_factory&) = delete;
+
+        // Move constructor
+        hash_cons_factory(hash_cons_factory &&rhs) noexcept
+            : hash_cons_factory()
+        { swap(rhs); }
+
+        // Move assignment
+        hash_cons_factory& operator=(hash_cons_factory &&rhs) noexcept
+        { hash_cons_factory tmp(std::move(rhs)); swap(tmp); return *this; }
+
+        ~hash_cons_factory();
+        void swap(hash_cons_factory &rhs) noexcept;
+
+
+        //****** Access ******//
+        [[nodiscard]] int size() const noexcept     { return static_cast<int>(m_nodes.size()); }
+        [[nodiscard]] bool owns(const bitree_node*) const noexcept;
+
+
+        //****** Modifiers ******//
+        // Returns the unique node holding value over the given interned subtrees, allocating it on first use
+        [[nodiscard]] const bitree_node* make(const Tp&, const bitree_node* = nullptr, const bitree_node* = nullptr);
+
+        // Interns a copy of an arbitrary (e.g. binary_tree-owned) subtree, sharing every repeated subtree
+        [[nodiscard]] const bitree_node* intern(const bitree_node*);
+
+        // Frees every node not reachable from the given roots
+        void collect(std::span<const bitree_node* const>);
+
+
+    private:
+        // Buckets by the hash of (value, left, right); children are interned, so they hash by address
+        std::unordered_multimap<std::size_t, bitree_node*> m_nodes;
+
+        [[nodiscard]] static std::size_t digest(const Tp&, const bitree_node*, const bitree_node*) noexcept;
+
+    };  // class hash_cons_factory
+
+
+
+    //************ Member Function Implementations ************//
+
+
+    // Destructor
+    template <Comparable Tp> requires Hashable<Tp>
+    hash_cons_factory<Tp>::~hash_cons_factory()
+    {
+        for (auto &[hash, node] : m_nodes)
+        {
+            delete node;
+            node = nullptr;
+        }
+    }
+
+
+    // Member swap function
+    template <Comparable Tp> requires Hashable<Tp>
+    void hash_cons_factory<Tp>::swap(hash_cons_factory<Tp> &rhs) noexcept
+    {
+        using std::swap;
+        swap(rhs.m_nodes, m_nodes);
+    }
+
+
+    // Hashes the triple that identifies an interned node
+    template <Comparable Tp> requires Hashable<Tp>
+    std::size_t hash_cons_factory<Tp>::digest(const Tp &value, const bitree_node *const left, const bitree_node *const right) noexcept
+    {
+        const auto pointer_hash = std::hash<const bitree_node*>{};
+        return hash_combine(hash_combine(std::hash<Tp>{}(value), pointer_hash(left)), pointer_hash(right));
+    }
+
+
+    // Checks if a live node was interned by this factory
+    template <Comparable Tp> requires Hashable<Tp>
+    bool hash_cons_factory<Tp>::owns(const bitree_node *const node) const noexcept
+    {
+        if (node == nullptr)
+            return false;
+
+        auto [first, last] = m_nodes.equal_range(digest(node->m_value, node->m_left, node->m_right));
+        for (; first != last; ++first)
+        {
+            if (first->second == node)
+                return true;
+        }
+        return false;
+    }
+
+
+    // Looks the triple up and allocates a node for it only if it has not been seen before
+    template <Comparable Tp> requires Hashable<Tp>
+    const typename hash_cons_factory<Tp>::bitree_node*
+    hash_cons_factory<Tp>::make(const Tp &value, const bitree_node *const left, const bitree_node *const right)
+    {
+        const auto hash = digest(value, left, right);
+        auto [first, last] = m_nodes.equal_range(hash);
+        for (; first != last; ++first)
+        {
+            const auto *node = first->second;
+            if (node->m_left == left && node->m_right == right && node->m_value == value)
+                return node;
+        }
+
+        auto *node = new bitree_node(value);
+        node->m_left = const_cast<bitree_node*>(left);
+        node->m_right = const_cast<bitree_node*>(right);
+        try { m_nodes.emplace(hash, node); }
+        catch (...) { delete node; throw; }
+        return node;
+    }
+
+
+    // Interns a subtree bottom-up with an explicit post-order stack of interned children
+    template <Comparable Tp> requires Hashable<Tp>
+    const typename hash_cons_factory<Tp>::bitree_node*
+    hash_cons_factory<Tp>::intern(const bitree_node *const root)
+    {
+        auto s { details::node_stack<const bitree_node*>{} };
+        auto results { details::node_stack<const bitree_node*>{} };
+        const bitree_node *curr = root, *last = nullptr;
+
+        while (curr != nullptr || !s.empty())
+        {
+            if (curr != nullptr)
+            {
+                s.push(curr);
+                curr = curr->m_left;
+                continue;
+            }
+
+            const auto *top = s.top();
+            if (top->m_right != nullptr && top->m_right != last)
+            {
+                curr = top->m_right;
+                continue;
+            }
+
+            // Children finish before their parent, so their interned nodes sit on top (right above left)
+            const bitree_node *r = nullptr, *l = nullptr;
+            if (top->m_right != nullptr) { r = results.top(); results.pop(); }
+            if (top->m_left != nullptr)  { l = results.top(); results.pop(); }
+            results.push(make(top->m_value, l, r));
+
+            last = top;
+            s.pop();
+        }
+
+        return results.empty() ? nullptr : results.top();
+    }
+
+
+    // Marks the nodes reachable from the roots, then frees the rest
+    template <Comparable Tp> requires Hashable<Tp>
+    void hash_cons_factory<Tp>::collect(const std::span<const bitree_node* const> roots)
+    {
+        auto reachable { std::unordered_set<const bitree_node*>{} };
+        auto s { details::node_stack<const bitree_node*>{} };
+        for (const auto *root : roots)
+        {
+            if (root != nullptr)
+                s.push(root);
+        }
+
+        while (!s.empty())
+        {
+            const auto *curr = s.top();
+            s.pop();
+
+            // Shared subtrees are walked once
+            if (!reachable.insert(curr).second)
+                continue;
+            if (curr->m_left != nullptr)
+                s.push(curr->m_left);
+            if (curr->m_right != nullptr)
+                s.push(curr->m_right);
+        }
+
+        for (auto it = m_nodes.begin(); it != m_nodes.end();)
+        {
+            if (reachable.contains(it->second))
+            {
+                ++it;
+                continue;
+            }
+            delete it->second;
+            it = m_nodes.erase(it);
+        }
+    }
+
+
+    //************ Non-Member Function Implementations ************//
+
+
+    template <Comparable Tp> requires Hashable<Tp>
+    void swap(hash_cons_factory<Tp> &lhs, hash_cons_factory<Tp> &rhs) noexcept
+    { lhs.swap(rhs); }
+
+}   // namespace nonlinear::tree
+
+
+#endif //DS_GRAPH_HASH_CONS_FACTORY_H
@@ -0,0 +1,264 @@
+#ifndef DS_GRAPH_INTERVAL_TREE_H
+#define DS_GRAPH_INTERVAL_TREE_H
+
+
+#include <algorithm>
+#include <concepts>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "avl_tree.h"
+
+
+namespace dsl::nonlinear::tree
+{
+    // Closed interval [m_low, m_high]; ordered by low endpoint, then by high endpoint
+    template <Comparable Tp>
+    struct interval
+    {
+        constexpr interval(const Tp &low, const Tp &high) noexcept
+            : m_low(low),
+              m_high(high) {}
+
+        [[nodiscard]] constexpr bool contains(const Tp &point) const noexcept
+        { return !(point < m_low) && !(m_high < point); }
+
+        [[nodiscard]] constexpr bool overlaps(const interval &rhs) const noexcept
+        { return !(rhs.m_high < m_low) && !(m_high < rhs.m_low); }
+
+        friend constexpr bool operator==(const interval &lhs, const interval &rhs) noexcept
+        { return lhs.m_low == rhs.m_low && lhs.m_high == rhs.m_high; }
+
+        friend constexpr bool operator<(const interval &lhs, const interval &rhs) noexcept
+        { return lhs.m_low < rhs.m_low || (lhs.m_low == rhs.m_low && lhs.m_high < rhs.m_high); }
+
+        friend constexpr bool operator!=(const interval &lhs, const interval &rhs) noexcept { return !(lhs == rhs); }
+        friend constexpr bool operator>(const interval &lhs, const interval &rhs) noexcept  { return rhs < lhs; }
+        friend constexpr bool operator<=(const interval &lhs, const interval &rhs) noexcept { return !(rhs < lhs); }
+        friend constexpr bool operator>=(const interval &lhs, const interval &rhs) noexcept { return !(lhs < rhs); }
+
+        Tp m_low, m_high;
+
+    };  // struct interval
+
+
+
+    namespace details
+    {
+        template <Comparable Tp>
+        struct interval_node : public avl_node<interval<Tp>>
+        {
+            constexpr explicit interval_node(const interval<Tp> &value) noexcept
+                : avl_node<interval<Tp>>(value),
+                  m_max(value.m_high) {}
+
+            constexpr explicit interval_node(interval<Tp> &&value) noexcept(std::is_nothrow_move_constructible_v<interval<Tp>>)
+                : avl_node<interval<Tp>>(std::move(value)),
+                  m_max(this->m_value.m_high) {}
+
+            ~interval_node() noexcept = default;
+
+            [[nodiscard]] std::size_t footprint() const noexcept override
+            { return sizeof(interval_node); }
+
+            [[nodiscard]] bitree_node<interval<Tp>>* clone_into(void *const where) const override
+            { return this->copy_of(*this, where); }
+
+            Tp m_max;   // greatest high endpoint in the subtree rooted here
+
+        };  // struct interval_node
+
+    }   // namespace details
+
+
+
+    template <Comparable Tp>
+    class interval_tree : public avl_tree<interval<Tp>>
+    {
+    public:
+        using bitree_node = typename avl_tree<interval<Tp>>::bitree_node;
+        using interval_node = typename details::interval_node<Tp>;
+
+
+        //****** Member Functions ******//
+
+        // No-throw constructor
+        interval_tree() noexcept
+            : avl_tree<interval<Tp>>() {}
+
+        // Copy constructor
+        interval_tree(const interval_tree &rhs)
+            : avl_tree<interval<Tp>>(rhs) {}
+
+        // Move constructor
+        interval_tree(interval_tree &&rhs) noexcept
+            : avl_tree<interval<Tp>>(std::move(rhs)) {}
+
+        // Pass-by-value copy/move assignment
+        interval_tree& operator=(interval_tree rhs) noexcept
+        { avl_tree<interval<Tp>>::operator=(std::move(rhs)); return *this; }
+
+        ~interval_tree() = default;
+
+        // Builds a balanced tree in O(n) from a sorted range of unique intervals; throws if any interval is reversed
+        template <std::random_access_iterator It>
+        [[nodiscard]] static interval_tree from_sorted(It first, It last)
+        { check_endpoints(first, last); interval_tree t; t.assign_sorted(first, last, false); return t; }
+
+        // As from_sorted, building the left and right subtrees of large ranges concurrently
+        template <std::random_access_iterator It>
+        [[nodiscard]] static interval_tree from_sorted_parallel(It first, It last)
+        { check_endpoints(first, last); interval_tree t; t.assign_sorted(first, last, true); return t; }
+
+
+        //****** Queries ******//
+        [[nodiscard]] constexpr bool overlaps(const interval<Tp>&) const noexcept;
+
+        template <std::invocable<const interval<Tp>&> Fn>
+        constexpr void for_each_overlapping(const interval<Tp> &query, Fn &&fn) const
+        { visit_overlapping(this->m_root, query, fn); }
+
+        template <std::invocable<const interval<Tp>&> Fn>
+        constexpr void for_each_containing(const Tp &point, Fn &&fn) const
+        { visit_overlapping(this->m_root, interval<Tp>(point, point), fn); }
+
+
+        //****** Modifiers ******//
+        constexpr bool push(const interval<Tp>&) override;     // throws if the interval is reversed
+        constexpr bool push(interval<Tp>&&) override;
+
+
+        //****** Set Operations ******//
+        // Restricted to interval trees, so every node linked in carries a max endpoint
+        [[nodiscard]] interval_tree split(const interval<Tp>&);
+        void join(interval_tree rhs)              { avl_tree<interval<Tp>>::join(std::move(rhs)); }
+        void union_with(interval_tree rhs)        { avl_tree<interval<Tp>>::union_with(std::move(rhs)); }
+        void intersect_with(interval_tree rhs)    { avl_tree<interval<Tp>>::intersect_with(std::move(rhs)); }
+        void difference_with(interval_tree rhs)   { avl_tree<interval<Tp>>::difference_with(std::move(rhs)); }
+
+
+    protected:
+        [[nodiscard]] bitree_node* make_node(const interval<Tp> &value) const override
+        { return this->template create_node<interval_node>(value); }
+
+        [[nodiscard]] bitree_node* make_node(interval<Tp> &&value) const override
+        { return this->template create_node<interval_node>(std::move(value)); }
+
+        constexpr void refresh(bitree_node*) const noexcept override;
+
+
+    private:
+        [[nodiscard]] static constexpr const Tp& max_high(const bitree_node *const node) noexcept
+        { return static_cast<const interval_node*>(node)->m_max; }
+
+        template <typename Fn>
+        constexpr void visit_overlapping(const bitree_node*, const interval<Tp>&, Fn&) const;
+
+        template <std::random_access_iterator It>
+        static void check_endpoints(It, It);
+
+    };  // class interval_tree
+
+
+
+    //************ Member Function Implementations ************//
+
+
+    // Recomputes the height, size and greatest high endpoint of a node from its children
+    template <Comparable Tp>
+    constexpr void interval_tree<Tp>::refresh(bitree_node *const node) const noexcept
+    {
+        avl_tree<interval<Tp>>::refresh(node);
+
+        auto *n = static_cast<interval_node*>(node);
+        n->m_max = node->m_value.m_high;
+        if (node->m_left != nullptr && n->m_max < max_high(node->m_left))
+            n->m_max = max_high(node->m_left);
+        if (node->m_right != nullptr && n->m_max < max_high(node->m_right))
+            n->m_max = max_high(node->m_right);
+    }
+
+
+    // Checks if any stored interval overlaps the query, in O(log n)
+    template <Comparable Tp>
+    constexpr bool interval_tree<Tp>::overlaps(const interval<Tp> &query) const noexcept
+    {
+        const bitree_node *curr = this->m_root;
+        while (curr != nullptr)
+        {
+            if (curr->m_value.overlaps(query))
+                return true;
+
+            // If the left subtree reaches the query at all, an overlap there is guaranteed or none exists right
+            curr = (curr->m_left != nullptr && !(max_high(curr->m_left) < query.m_low))
+                    ? curr->m_left : curr->m_right;
+        }
+        return false;
+    }
+
+
+    // for_each_overlapping helper function; prunes subtrees ending before the query or starting after it
+    template <Comparable Tp>
+    template <typename Fn>
+    constexpr void interval_tree<Tp>::visit_overlapping(const bitree_node *const root, const interval<Tp> &query, Fn &fn) const
+    {
+        if (root == nullptr || max_high(root) < query.m_low)
+            return;
+
+        visit_overlapping(root->m_left, query, fn);
+
+        // Every interval to the right starts no earlier than this one
+        if (query.m_high < root->m_value.m_low)
+            return;
+
+        if (root->m_value.overlaps(query))
+            fn(root->m_value);
+        visit_overlapping(root->m_right, query, fn);
+    }
+
+
+    // Splits off and returns the intervals greater than or equal to value
+    template <Comparable Tp>
+    interval_tree<Tp> interval_tree<Tp>::split(const interval<Tp> &value)
+    {
+        auto result = interval_tree{};
+        static_cast<avl_tree<interval<Tp>>&>(result) = avl_tree<interval<Tp>>::split(value);
+        return result;
+    }
+
+
+    // from_sorted helper function; rejects reversed intervals as push does
+    template <Comparable Tp>
+    template <std::random_access_iterator It>
+    void interval_tree<Tp>::check_endpoints(It first, It last)
+    {
+        if (std::any_of(first, last, [](const interval<Tp> &value) { return value.m_high < value.m_low; }))
+            throw std::invalid_argument("Cannot insert an interval whose high endpoint precedes its low endpoint.");
+    }
+
+
+    // Inserts an interval and balances the tree
+    template <Comparable Tp>
+    constexpr bool interval_tree<Tp>::push(const interval<Tp> &value)
+    {
+        if (value.m_high < value.m_low)
+            throw std::invalid_argument("Cannot insert an interval whose high endpoint precedes its low endpoint.");
+        return avl_tree<interval<Tp>>::push(value);
+    }
+
+
+    // As push, moving the interval into the new node
+    template <Comparable Tp>
+    constexpr bool interval_tree<Tp>::push(interval<Tp> &&value)
+    {
+        if (value.m_high < value.m_low)
+            throw std::invalid_argument("Cannot insert an interval whose high endpoint precedes its low endpoint.");
+        return avl_tree<interval<Tp>>::push(std::move(value));
+    }
+
+}   // namespace nonlinear::tree
+
+
+#endif //DS_GRAPH_INTERVAL_TREE_H
@@ -0,0 +1,290 @@
+#ifndef DS_GRAPH_KARY_SEARCH_INDEX_H
+#define DS_GRAPH_KARY_SEARCH_INDEX_H
+
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "binary_search_tree.h"
+
+
+namespace dsl::nonlinear::tree
+{
+    // Read-only ordered index for arithmetic keys; each node is one cache line of keys compared at once
+    template <Comparable Tp>
+        requires std::is_arithmetic_v<Tp>
+    class kary_search_index
+    {
+    public:
+        // Keys per node (8 for 64-bit keys, 16 otherwise); a node has node_keys + 1 children
+        static constexpr const int node_keys = std::min<int>(16, cache_line_size / sizeof(Tp));
+
+
+        //****** Member Functions ******//
+
+        // No-throw constructor
+        kary_search_index() noexcept
+            : m_keys(nullptr),
+              m_size(0),
+              m_blocks(0) {}
+
+        // Constructs the index from the keys of a search tree (or any derived tree, e.g. avl_tree)
+        explicit kary_search_index(const binary_search_tree<Tp>&);
+
+        // Constructs the index from a sorted span
+        explicit kary_search_index(std::span<const Tp>);
+
+        // Copy constructor
+        kary_search_index(const kary_search_index&);
+
+        // Move constructor
+        kary_search_index(kary_search_index &&rhs) noexcept
+            : kary_search_index()
+        { swap(rhs); }
+
+        // Pass-by-value copy/move assignment
+        kary_search_index& operator=(kary_search_index rhs) noexcept
+        { swap(rhs); return *this; }
+
+        ~kary_search_index();
+        constexpr void swap(kary_search_index &rhs) noexcept;
+
+
+        //****** Access ******//
+        [[nodiscard]] constexpr int size() const noexcept     { return m_size; }
+        [[nodiscard]] constexpr bool empty() const noexcept   { return m_size == 0; }
+
+        [[nodiscard]] const Tp* lower_bound(Tp) const noexcept;
+        [[nodiscard]] const Tp* find(Tp) const noexcept;
+
+        [[nodiscard]] bool contains(const Tp value) const noexcept
+        { return find(value) != nullptr; }
+
+
+    private:
+        Tp *m_keys;         // m_blocks nodes of node_keys keys each, cache-line aligned
+        int m_size, m_blocks;
+        Tp m_last {};       // largest key; queries above it short-circuit before reaching padding
+
+        static constexpr const Tp padding = std::numeric_limits<Tp>::has_infinity
+                ? std::numeric_limits<Tp>::infinity() : std::numeric_limits<Tp>::max();
+
+        [[nodiscard]] static constexpr int child(const int block, const int i) noexcept
+        { return block * (node_keys + 1) + i + 1; }
+
+        [[nodiscard]] static int rank(const Tp*, Tp) noexcept;
+
+        void allocate();
+        template <typename Fn>
+        void build(Fn&, int&, int);
+
+    };  // class kary_search_index
+
+
+
+    //************ Member Function Implementations ************//
+
+
+    // Tree constructor
+    template <Comparable Tp> requires std::is_arithmetic_v<Tp>
+    kary_search_index<Tp>::kary_search_index(const binary_search_tree<Tp> &tree)
+        : kary_search_index()
+    {
+        m_size = tree.size();
+        if (m_size == 0) return;
+
+        auto nodes = tree.toVector(*tree.root());
+        auto at = [&nodes](const int i) -> Tp { return nodes[i]->m_value; };
+        allocate();
+
+        auto t = 0;
+        build(at, t, 0);
+        m_last = nodes.back()->m_value;
+    }
+
+
+    // Sorted span constructor
+    template <Comparable Tp> requires std::is_arithmetic_v<Tp>
+    kary_search_index<Tp>::kary_search_index(const std::span<const Tp> sorted)
+        : kary_search_index()
+    {
+        m_size = static_cast<int>(sorted.size());
+        if (m_size == 0) return;
+
+        auto at = [sorted](const int i) -> Tp { return sorted[i]; };
+        allocate();
+
+        auto t = 0;
+        build(at, t, 0);
+        m_last = sorted.back();
+    }
+
+
+    // Copy constructor
+    template <Comparable Tp> requires std::is_arithmetic_v<Tp>
+    kary_search_index<Tp>::kary_search_index(const kary_search_index<Tp> &rhs)
+        : m_keys(nullptr),
+          m_size(rhs.m_size),
+          m_blocks(rhs.m_blocks),
+          m_last(rhs.m_last)
+    {
+        if (m_size == 0) return;
+
+        allocate();
+        std::copy_n(rhs.m_keys, m_blocks * node_keys, m_keys);
+    }
+
+
+    // Destructor
+    template <Comparable Tp> requires std::is_arithmetic_v<Tp>
+    kary_search_index<Tp>::~kary_search_index()
+    {
+        if (m_keys == nullptr) return;
+
+        ::operator delete(m_keys, std::align_val_t{cache_line_size});
+        m_keys = nullptr;
+    }
+
+
+    // Member swap function
+    template <Comparable Tp> requires std::is_arithmetic_v<Tp>
+    constexpr void kary_search_index<Tp>::swap(kary_search_index<Tp> &rhs) noexcept
+    {
+        using std::swap;
+        swap(rhs.m_keys, m_keys);
+        swap(rhs.m_size, m_size);
+        swap(rhs.m_blocks, m_blocks);
+        swap(rhs.m_last, m_last);
+    }
+
+
+    // Allocates cache-aligned storage for every node needed to hold m_size keys
+    template <Comparable Tp> requires std::is_arithmetic_v<Tp>
+    void kary_search_index<Tp>::allocate()
+    {
+        m_blocks = (m_size + node_keys - 1) / node_keys;
+        m_keys = static_cast<Tp*>(::operator new(m_blocks * node_keys * sizeof(Tp), std::align_val_t{cache_line_size}));
+    }
+
+
+    // Fills the nodes in in-order; once the keys run out, every remaining slot takes the greatest key
+    // The padding therefore ends the in-order sequence, and can sit in internal nodes, not only in the last node
+    template <Comparable Tp> requires std::is_arithmetic_v<Tp>
+    template <typename Fn>
+    void kary_search_index<Tp>::build(Fn &at, int &t, const int block)
+    {
+        if (block >= m_blocks) return;
+
+        for (auto i = 0; i < node_keys; i++)
+        {
+            build(at, t, child(block, i));
+            m_keys[block * node_keys + i] = (t < m_size) ? at(t++) : padding;
+        }
+        build(at, t, child(block, node_keys));
+    }
+
+
+    // Counts the keys in one node that are less than value, comparing the whole node at once
+    template <Comparable Tp> requires std::is_arithmetic_v<Tp>
+    int kary_search_index<Tp>::rank(const Tp *const node, const Tp value) noexcept
+    {
+#if defined(__AVX2__)
+        if constexpr (std::is_same_v<Tp, std::int32_t>)
+        {
+            const auto x = _mm256_set1_epi32(value);
+            const auto lo = _mm256_cmpgt_epi32(x, _mm256_load_si256(reinterpret_cast<const __m256i*>(node)));
+            const auto hi = _mm256_cmpgt_epi32(x, _mm256_load_si256(reinterpret_cast<const __m256i*>(node + 8)));
+            const auto mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(lo))) |
+                              static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(hi))) << 8;
+            return std::popcount(mask);
+        }
+        else if constexpr (std::is_same_v<Tp, std::int64_t>)
+        {
+            const auto x = _mm256_set1_epi64x(value);
+            const auto lo = _mm256_cmpgt_epi64(x, _mm256_load_si256(reinterpret_cast<const __m256i*>(node)));
+            const auto hi = _mm256_cmpgt_epi64(x, _mm256_load_si256(reinterpret_cast<const __m256i*>(node + 4)));
+            const auto mask = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(lo))) |
+                              static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(hi))) << 4;
+            return std::popcount(mask);
+        }
+        else if constexpr (std::is_same_v<Tp, float>)
+        {
+            const auto x = _mm256_set1_ps(value);
+            const auto lo = _mm256_cmp_ps(_mm256_load_ps(node), x, _CMP_LT_OQ);
+            const auto hi = _mm256_cmp_ps(_mm256_load_ps(node + 8), x, _CMP_LT_OQ);
+            const auto mask = static_cast<unsigned>(_mm256_movemask_ps(lo)) |
+                              static_cast<unsigned>(_mm256_movemask_ps(hi)) << 8;
+            return std::popcount(mask);
+        }
+        else if constexpr (std::is_same_v<Tp, double>)
+        {
+            const auto x = _mm256_set1_pd(value);
+            const auto lo = _mm256_cmp_pd(_mm256_load_pd(node), x, _CMP_LT_OQ);
+            const auto hi = _mm256_cmp_pd(_mm256_load_pd(node + 4), x, _CMP_LT_OQ);
+            const auto mask = static_cast<unsigned>(_mm256_movemask_pd(lo)) |
+                              static_cast<unsigned>(_mm256_movemask_pd(hi)) << 4;
+            return std::popcount(mask);
+        }
+        else
+#endif
+        {
+            // Branch-free count over a fixed-width node; vectorized by the compiler
+            auto count = 0;
+            for (auto i = 0; i < node_keys; i++)
+                count += static_cast<int>(node[i] < value);
+            return count;
+        }
+    }
+
+
+    // Returns the smallest key not less than value, or nullptr if every key is less than value
+    template <Comparable Tp> requires std::is_arithmetic_v<Tp>
+    const Tp* kary_search_index<Tp>::lower_bound(const Tp value) const noexcept
+    {
+        if (m_size == 0 || m_last < value)
+            return nullptr;
+
+        const Tp *result = nullptr;
+        auto block = 0;
+        while (block < m_blocks)
+        {
+            const auto *node = m_keys + block * node_keys;
+            const auto i = rank(node, value);
+            if (i < node_keys)
+                result = node + i;
+            block = child(block, i);
+        }
+        return result;
+    }
+
+
+    // Returns the key equal to value, if it exists
+    template <Comparable Tp> requires std::is_arithmetic_v<Tp>
+    const Tp* kary_search_index<Tp>::find(const Tp value) const noexcept
+    {
+        const auto *lb = lower_bound(value);
+        return (lb != nullptr && *lb == value) ? lb : nullptr;
+    }
+
+
+    //************ Non-Member Function Implementations ************//
+
+
+    template <Comparable Tp> requires std::is_arithmetic_v<Tp>
+    constexpr void swap(kary_search_index<Tp> &lhs, kary_search_index<Tp> &rhs) noexcept
+    { lhs.swap(rhs); }
+
+}   // namespace nonlinear::tree
+
+
+#endif //DS_GRAPH_KARY_SEARCH_INDEX_H
@@ -0,0 +1,340 @@
+#ifndef DS_GRAPH_LOCK_FREE_BST_H
+#define DS_GRAPH_LOCK_FREE_BST_H
+
+
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "epoch.h"
+#include "traits.h"
+
+
+namespace dsl::nonlinear::tree
+{
+    namespace details
+    {
+        // Node of an external search tree: leaves hold the keys, internal nodes only route
+        // The two low bits of each child word mark the edge: flag = leaf below is being deleted,
+        // tag = the node owning the edge is being spliced out
+        template <Comparable Tp>
+        struct lf_node
+        {
+            static constexpr const std::uintptr_t flag_bit = 1, tag_bit = 2, mark_bits = flag_bit | tag_bit;
+
+            // Key node; rank 1 and 2 are sentinel keys greater than every value
+            explicit lf_node(const Tp &value, const int rank = 0)
+                : m_value(value),
+                  m_rank(rank) {}
+
+            explicit lf_node(Tp &&value) noexcept(std::is_nothrow_move_constructible_v<Tp>)
+                : m_value(std::move(value)),
+                  m_rank(0) {}
+
+            [[nodiscard]] static lf_node* address(const std::uintptr_t word) noexcept
+            { return reinterpret_cast<lf_node*>(word & ~mark_bits); }
+
+            [[nodiscard]] static std::uintptr_t word(const lf_node *const node, const std::uintptr_t marks = 0) noexcept
+            { return reinterpret_cast<std::uintptr_t>(node) | marks; }
+
+            // Orders a value against this node's key
+            [[nodiscard]] bool greater_than(const Tp &value) const noexcept   { return m_rank > 0 || value < m_value; }
+            [[nodiscard]] bool holds(const Tp &value) const noexcept          { return m_rank == 0 && m_value == value; }
+
+            const Tp m_value;
+            const int m_rank;
+            std::atomic<std::uintptr_t> m_left {0}, m_right {0};    // both 0 for a leaf
+
+        };  // struct lf_node
+
+    }   // namespace details
+
+
+
+    // Lock-free ordered set (Natarajan and Mittal's external BST); push, pop, find and contains may be called
+    // from any thread. Deletion flags the edge to a leaf and then splices out its parent with one CAS, and
+    // unlinked nodes are reclaimed through the shared epoch domain
+    template <Comparable Tp> requires std::default_initializable<Tp>
+    class lock_free_bst
+    {
+    public:
+        using lf_node = typename details::lf_node<Tp>;
+
+
+        //****** Member Functions ******//
+
+        lock_free_bst();
+
+        lock_free_bst(const lock_free_bst&) = delete;
+        lock_free_bst& operator=(const lock_free_bst&) = delete;
+
+        // Not safe to run concurrently with any other operation on the tree
+        ~lock_free_bst();
+
+
+        //****** Access ******//
+        // Exact when no update is in flight
+        [[nodiscard]] int size() const noexcept     { return m_size.load(std::memory_order_relaxed); }
+        [[nodiscard]] bool empty() const noexcept   { return size() == 0; }
+
+        [[nodiscard]] bool contains(const Tp&) const;
+        [[nodiscard]] std::optional<Tp> find(const Tp&) const;     // a copy; the node may be reclaimed afterwards
+
+
+        //****** Modifiers ******//
+        bool push(const Tp &value)  { return push_leaf(new lf_node(value)); }
+        bool push(Tp &&value)       { return push_leaf(new lf_node(std::move(value))); }
+        bool pop(const Tp&);
+
+        // Builds the value from args once and moves it into its leaf
+        template <typename... Args> requires std::constructible_from<Tp, Args...>
+        bool emplace(Args &&...args)
+        { return push(Tp(std::forward<Args>(args)...)); }
+
+
+    private:
+        // Last nodes on the search path: leaf, its parent, and the deepest ancestor -> successor edge left untagged
+        struct seek_record
+        {
+            lf_node *m_ancestor, *m_successor, *m_parent, *m_leaf;
+        };
+
+        lf_node *m_root;    // sentinel rank 2; its left child is the sentinel rank 1 node whose left subtree holds the keys
+        std::atomic<int> m_size {0};
+
+        [[nodiscard]] static std::atomic<std::uintptr_t>& child(lf_node *const node, const Tp &value) noexcept
+        { return node->greater_than(value) ? node->m_left : node->m_right; }
+
+        [[nodiscard]] seek_record seek(const Tp&) const noexcept;
+        bool push_leaf(lf_node*);
+        bool cleanup(const Tp&, const seek_record&);
+        static void retire_spliced(const Tp&, lf_node*, lf_node*, lf_node*);
+
+    };  // class lock_free_bst
+
+
+
+    //************ Member Function Implementations ************//
+
+
+    // Builds the sentinel frame: two internal nodes over three sentinel leaves, so every seek has an ancestor
+    template <Comparable Tp> requires std::default_initializable<Tp>
+    lock_free_bst<Tp>::lock_free_bst()
+        : m_root(new lf_node(Tp{}, 2))
+    {
+        auto *s = new lf_node(Tp{}, 1);
+        s->m_left.store(lf_node::word(new lf_node(Tp{}, 1)), std::memory_order_relaxed);
+        s->m_right.store(lf_node::word(new lf_node(Tp{}, 1)), std::memory_order_relaxed);
+        m_root->m_left.store(lf_node::word(s), std::memory_order_relaxed);
+        m_root->m_right.store(lf_node::word(new lf_node(Tp{}, 2)), std::memory_order_relaxed);
+    }
+
+
+    // Destructor; frees every node still linked (retired nodes belong to the epoch domain)
+    template <Comparable Tp> requires std::default_initializable<Tp>
+    lock_free_bst<Tp>::~lock_free_bst()
+    {
+        auto s { std::vector<lf_node*>{m_root} };
+        while (!s.empty())
+        {
+            auto *curr = s.back();
+            s.pop_back();
+
+            if (auto *left = lf_node::address(curr->m_left.load(std::memory_order_relaxed)); left != nullptr)
+                s.push_back(left);
+            if (auto *right = lf_node::address(curr->m_right.load(std::memory_order_relaxed)); right != nullptr)
+                s.push_back(right);
+            delete curr;
+        }
+        m_root = nullptr;
+    }
+
+
+    // Walks from the root to the leaf where value belongs, remembering the last untagged edge above it
+    template <Comparable Tp> requires std::default_initializable<Tp>
+    typename lock_free_bst<Tp>::seek_record lock_free_bst<Tp>::seek(const Tp &value) const noexcept
+    {
+        auto *s = lf_node::address(m_root->m_left.load(std::memory_order_acquire));
+        auto record = seek_record{m_root, s, s, lf_node::address(s->m_left.load(std::memory_order_acquire))};
+
+        auto parent_word = s->m_left.load(std::memory_order_acquire);
+        auto current_word = record.m_leaf->m_left.load(std::memory_order_acquire);
+        auto *current = lf_node::address(current_word);
+
+        while (current != nullptr)
+        {
+            if (!(parent_word & lf_node::tag_bit))
+            {
+                record.m_ancestor = record.m_parent;
+                record.m_successor = record.m_leaf;
+            }
+            record.m_parent = record.m_leaf;
+            record.m_leaf = current;
+
+            parent_word = current_word;
+            current_word = child(current, value).load(std::memory_order_acquire);
+            current = lf_node::address(current_word);
+        }
+        return record;
+    }
+
+
+    // Checks if the value is in the set
+    template <Comparable Tp> requires std::default_initializable<Tp>
+    bool lock_free_bst<Tp>::contains(const Tp &value) const
+    {
+        auto guard = epoch_domain::shared().pin();
+        return seek(value).m_leaf->holds(value);
+    }
+
+
+    // Returns a copy of the stored value equal to value, if it exists
+    template <Comparable Tp> requires std::default_initializable<Tp>
+    std::optional<Tp> lock_free_bst<Tp>::find(const Tp &value) const
+    {
+        auto guard = epoch_domain::shared().pin();
+        const auto *leaf = seek(value).m_leaf;
+        return leaf->holds(value) ? std::optional<Tp>(leaf->m_value) : std::nullopt;
+    }
+
+
+    // Inserts a new leaf by swinging the parent's edge to a new internal node over the old and new leaves
+    template <Comparable Tp> requires std::default_initializable<Tp>
+    bool lock_free_bst<Tp>::push_leaf(lf_node *const leaf_node)
+    {
+        auto guard = epoch_domain::shared().pin();
+        const auto &value = leaf_node->m_value;
+        lf_node *internal = nullptr;
+
+        while (true)
+        {
+            const auto record = seek(value);
+            auto *leaf = record.m_leaf;
+            if (leaf->holds(value))
+            {
+                delete leaf_node;
+                delete internal;
+                return false;
+            }
+
+            // The new internal node routes by the greater of the two keys
+            delete internal;
+            internal = leaf->greater_than(value) ? new lf_node(leaf->m_value, leaf->m_rank) : new lf_node(value);
+            internal->m_left.store(lf_node::word(leaf->greater_than(value) ? leaf_node : leaf), std::memory_order_relaxed);
+            internal->m_right.store(lf_node::word(leaf->greater_than(value) ? leaf : leaf_node), std::memory_order_relaxed);
+
+            auto &edge = child(record.m_parent, value);
+            auto expected = lf_node::word(leaf);
+            if (edge.compare_exchange_strong(expected, lf_node::word(internal), std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                m_size.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+
+            // Help a pending deletion at this edge finish before retrying
+            if (lf_node::address(expected) == leaf && (expected & lf_node::mark_bits))
+                cleanup(value, record);
+        }
+    }
+
+
+    // Removes a value: flag the edge to its leaf (injection), then splice the leaf's parent out (cleanup)
+    template <Comparable Tp> requires std::default_initializable<Tp>
+    bool lock_free_bst<Tp>::pop(const Tp &value)
+    {
+        auto guard = epoch_domain::shared().pin();
+        lf_node *target = nullptr;
+
+        while (true)
+        {
+            const auto record = seek(value);
+
+            if (target == nullptr)
+            {
+                auto *leaf = record.m_leaf;
+                if (!leaf->holds(value))
+                    return false;
+
+                auto &edge = child(record.m_parent, value);
+                auto expected = lf_node::word(leaf);
+                if (edge.compare_exchange_strong(expected, lf_node::word(leaf, lf_node::flag_bit),
+                                                 std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    // The value is logically deleted from here on; retries only help the splice along
+                    target = leaf;
+                    m_size.fetch_sub(1, std::memory_order_relaxed);
+                    if (cleanup(value, record))
+                        return true;
+                }
+                else if (lf_node::address(expected) == leaf && (expected & lf_node::mark_bits))
+                    cleanup(value, record);
+            }
+            else
+            {
+                // Another thread's cleanup already unlinked the flagged leaf
+                if (record.m_leaf != target || cleanup(value, record))
+                    return true;
+            }
+        }
+    }
+
+
+    // Tags the sibling of the flagged leaf, then swings the ancestor's edge from successor to that sibling
+    // Returns true if this call performed the splice (and so retired the spliced nodes)
+    template <Comparable Tp> requires std::default_initializable<Tp>
+    bool lock_free_bst<Tp>::cleanup(const Tp &value, const seek_record &record)
+    {
+        auto &successor_edge = child(record.m_ancestor, value);
+        auto *child_edge = &child(record.m_parent, value);
+        auto *sibling_edge = (child_edge == &record.m_parent->m_left) ? &record.m_parent->m_right : &record.m_parent->m_left;
+
+        // If the leaf on value's side is not the flagged one, its sibling is being deleted and this leaf survives
+        if (!(child_edge->load(std::memory_order_acquire) & lf_node::flag_bit))
+            sibling_edge = child_edge;
+
+        sibling_edge->fetch_or(lf_node::tag_bit, std::memory_order_acq_rel);
+        const auto sibling = sibling_edge->load(std::memory_order_acquire);
+
+        auto expected = lf_node::word(record.m_successor);
+        if (!successor_edge.compare_exchange_strong(expected, sibling & ~lf_node::tag_bit,
+                                                    std::memory_order_acq_rel, std::memory_order_acquire))
+            return false;
+
+        retire_spliced(value, record.m_successor, record.m_parent, lf_node::address(sibling));
+        return true;
+    }
+
+
+    // Retires the chain successor .. parent now unlinked by a cleanup, with each node's flagged leaf
+    // Every node above parent on the chain continues toward value along a tagged edge; its other child is a flagged leaf
+    template <Comparable Tp> requires std::default_initializable<Tp>
+    void lock_free_bst<Tp>::retire_spliced(const Tp &value, lf_node *curr, lf_node *const parent, lf_node *const kept)
+    {
+        auto &domain = epoch_domain::shared();
+        while (true)
+        {
+            auto *left = lf_node::address(curr->m_left.load(std::memory_order_acquire));
+            auto *right = lf_node::address(curr->m_right.load(std::memory_order_acquire));
+
+            if (curr == parent)
+            {
+                domain.retire((left == kept) ? right : left);
+                domain.retire(curr);
+                return;
+            }
+
+            auto *next = curr->greater_than(value) ? left : right;
+            domain.retire((next == left) ? right : left);
+            domain.retire(curr);
+            curr = next;
+        }
+    }
+
+}   // namespace nonlinear::tree
+
+
+#endif //DS_GRAPH_LOCK_FREE_BST_H
@@ -2,6 +2,10 @@
 #define DS_GRAPH_MAX_HEAP_H
 
 
+#include <bit>
+#include <queue>
+#include <utility>
+
 #include "binary_tree.h"
 
 
@@ -25,33 +29,41 @@ namespace dsl::nonlinear::tree
 
         // Move constructor
         max_heap(max_heap &&rhs) noexcept
-            : binary_tree<Tp>(rhs) {}
+            : binary_tree<Tp>(std::move(rhs)) {}
 
         // Pass-by-value copy/move assignment
         max_heap& operator=(max_heap rhs) noexcept
-        { binary_tree<Tp>::operator=(rhs); return *this; }
+        { binary_tree<Tp>::operator=(std::move(rhs)); return *this; }
 
         ~max_heap() = default;
 
 
         //****** Modifiers ******//
-        constexpr void sift_up(const Tp&) noexcept;
-        constexpr void sift_down(const Tp&) noexcept;
+        constexpr void sift_up(const Tp&);
+        constexpr void sift_down(const Tp&);
 
-        constexpr void sift_up(bitree_node &node) noexcept       { try_sift_up(node); }
-        constexpr void sift_down(bitree_node &node) noexcept     { try_sift_down(node); }
+        constexpr void sift_up(bitree_node &node)                { try_sift_up(position_of(&node)); }
+        constexpr void sift_down(bitree_node &node)              { try_sift_down(node); }
 
-        constexpr void increase_key(const Tp&, const Tp&) noexcept;
-        constexpr void decrease_key(const Tp&, const Tp&) noexcept;
+        constexpr void increase_key(const Tp&, const Tp&);     // throws if new_value is less than old_value
+        constexpr void decrease_key(const Tp&, const Tp&);     // throws if new_value is greater than old_value
 
         [[nodiscard]] constexpr const Tp& max() const override { return this->m_root->m_value; }
         constexpr bool push(const Tp&) override;
+        constexpr bool push(Tp&&) override;
         constexpr bool pop(const Tp&) override;
 
 
     private:
-        constexpr void try_sift_up(bitree_node&) noexcept;
-        constexpr void try_sift_down(bitree_node&) noexcept;
+        constexpr void try_sift_up(unsigned);
+        constexpr void try_sift_down(bitree_node&);
+
+        // The heap is complete, so nodes are addressed by their 1-based level-order position; 0 if there is none
+        [[nodiscard]] constexpr unsigned locate(const Tp&) const;
+        [[nodiscard]] constexpr unsigned position_of(const bitree_node*) const;
+
+        template <typename Pred>
+        [[nodiscard]] constexpr unsigned search(Pred) const;
 
     };  // class max_heap
 
@@ -59,102 +71,92 @@ namespace dsl::nonlinear::tree
 
     //************ Member Function Implementations ************//
 
-    // sift_up helper function
+    // sift_up helper function; the ancestors of a position are read off its bits on the way down, so the climb
+    // back up takes O(log n) without looking up a single parent
     template <Comparable Tp>
-    constexpr void max_heap<Tp>::try_sift_up(bitree_node &node) noexcept
+    constexpr void max_heap<Tp>::try_sift_up(const unsigned position)
     {
-        auto path = this->pathTo(&node);
-        while (!path.empty())
-        {
-            auto *parent = path.front();
-            path.pop();
+        if (position == 0)
+            return;
 
-            if (parent->m_value >= value)
-                break;
+        auto path { details::node_stack<bitree_node*>{} };
+        auto *curr = this->m_root;
+        for (auto bit = std::bit_width(position) - 1; bit > 0; bit--)
+        {
+            path.push(curr);
+            curr = ((position >> (bit - 1)) & 1u) ? curr->m_right : curr->m_left;
+        }
 
-            // Swap
-            auto temp = parent->m_value;
-            parent->m_value = node->m_value;
-            node.m_value = temp;
-            node = *parent;
+        while (!path.empty() && path.top()->m_value < curr->m_value)
+        {
+            this->swap_values(path.top(), curr);
+            curr = path.top();
+            path.pop();
         }
     }
 
 
     template <Comparable Tp>
-    constexpr void max_heap<Tp>::sift_up(const Tp &value) noexcept
-    {
-        auto found = this->find(value);
-        if (found)
-        {
-            auto node = *found;
-            try_sift_up(node);
-        }
-    }
+    constexpr void max_heap<Tp>::sift_up(const Tp &value)
+    { try_sift_up(locate(value)); }
 
 
     // sift_down helper function
     template <Comparable Tp>
-    constexpr void max_heap<Tp>::try_sift_down(bitree_node &node) noexcept
+    constexpr void max_heap<Tp>::try_sift_down(bitree_node &node)
     {
         auto *curr = &node;
-        while (curr->m_left != nullptr || curr->m_right != nullptr)
+        while (curr->m_left != nullptr)
         {
-            bitree_node *b = nullptr;
-            if (curr->m_left != nullptr && curr->m_right != nullptr)
-                b = (curr->m_left->m_value < curr->m_right->m_value) ? curr->m_left : curr->m_right;
-            else
-                b = (curr->m_left != nullptr) ? curr->m_left : curr->m_right;
+            auto *b = curr->m_left;
+            if (curr->m_right != nullptr && b->m_value < curr->m_right->m_value)
+                b = curr->m_right;
 
-            auto temp = b->m_value;
-            b->m_value = curr->m_value;
-            curr->m_value = temp;
+            if (!(curr->m_value < b->m_value))
+                break;
+
+            this->swap_values(curr, b);
             curr = b;
         }
     }
 
 
     template <Comparable Tp>
-    constexpr void max_heap<Tp>::sift_down(const Tp &value) noexcept
+    constexpr void max_heap<Tp>::sift_down(const Tp &value)
     {
-        auto found = this->find(value);
-        bitree_node *node = (found) ? &(*found) : nullptr;
-
+        auto *node = this->find_node(value);
         if (node != nullptr)
-            try_sift_down(node);
+            try_sift_down(*node);
     }
 
 
     template <Comparable Tp>
-    constexpr void max_heap<Tp>::increase_key(const Tp &old_value, const Tp &new_value) noexcept
+    constexpr void max_heap<Tp>::increase_key(const Tp &old_value, const Tp &new_value)
     {
         if (new_value < old_value)
             throw std::invalid_argument("Argument 'new_value' must be greater than 'old_value'.");
 
-        auto found_p = this->parentOf(old_value);
-        if (found_p)
+        const auto position = locate(old_value);
+        if (position != 0)
         {
-            auto p = *found_p;
-            auto *child = (p.m_left->m_value == value) ? p.m_left : p.m_right;
-            child->m_value = new_value;
-            sift_up(*child);
+            bitree_node *parent = nullptr;
+            this->assign_value(this->level_order_at(position, parent), new_value);
+            try_sift_up(position);
         }
     }
 
 
     template <Comparable Tp>
-    constexpr void max_heap<Tp>::decrease_key(const Tp &old_value, const Tp &new_value) noexcept
+    constexpr void max_heap<Tp>::decrease_key(const Tp &old_value, const Tp &new_value)
     {
         if (old_value < new_value)
             throw std::invalid_argument("Argument 'new_value' must be less than 'old_value'.");
 
-        auto found_p = this->parentOf(old_value);
-        if (found_p)
+        auto *node = this->find_node(old_value);
+        if (node != nullptr)
         {
-            auto p = *found_p;
-            auto *child = (p.m_left->m_value == value) ? p.m_left : p.m_right;
-            child->m_value = new_value;
-            sift_down(*child);
+            this->assign_value(node, new_value);
+            try_sift_down(*node);
         }
     }
 
@@ -163,33 +165,95 @@ namespace dsl::nonlinear::tree
     constexpr bool max_heap<Tp>::push(const Tp &value)
     {
         if (!binary_tree<Tp>::push(value)) return false;
-        sift_up(value);
+        try_sift_up(static_cast<unsigned>(this->m_size));
+        return true;
+    }
+
+
+    template <Comparable Tp>
+    constexpr bool max_heap<Tp>::push(Tp &&value)
+    {
+        if (!binary_tree<Tp>::push(std::move(value))) return false;
+        try_sift_up(static_cast<unsigned>(this->m_size));
+        return true;
     }
 
 
     template <Comparable Tp>
     constexpr bool max_heap<Tp>::pop(const Tp &value)
     {
-        auto found_n = this->find(value);
-        if (!found_n) return false;
-
-        auto *n = *found_n, *last = this->last_level_order();
-        n->m_value = last->m_value;
-        delete last;
-        last = nullptr;
-
-        auto found_p = this->parentOf(*n);
-        if (found_p && (*found_p).m_value < n->m_value)
-            sift_up(*n);
-        else if ((n->m_left != nullptr && n->m_left->m_value > n->m_value) ||
-                 (n->m_right != nullptr && n->m_right->m_value > n->m_value))
-            sift_down(*n);
-
-        this->m_size--;
+        const auto position = locate(value);
+        if (position == 0) return false;
+
+        // The last node's value now sits in n and may violate the heap order in either direction
+        bitree_node *parent = nullptr;
+        auto *n = this->erase_node(this->level_order_at(position, parent));
+        if (n != nullptr)
+        {
+            if (parent != nullptr && parent->m_value < n->m_value)
+                try_sift_up(position);
+            else
+                try_sift_down(*n);
+        }
         return true;
     }
 
 
+    // Returns the position of a node holding the value; O(1) expected when indexed, otherwise one level-order pass
+    template <Comparable Tp>
+    constexpr unsigned max_heap<Tp>::locate(const Tp &value) const
+    {
+        if (this->indexed())
+            return position_of(this->find_node(value));
+        return search([&](const bitree_node &node) { return node.m_value == value; });
+    }
+
+
+    // Returns the position of the given node; with an index, each parent step reveals one bit of it, from the lowest up
+    template <Comparable Tp>
+    constexpr unsigned max_heap<Tp>::position_of(const bitree_node *const node) const
+    {
+        if (node == nullptr)
+            return 0;
+        if (!this->indexed())
+            return search([&](const bitree_node &curr) { return &curr == node; });
+
+        auto bits = 0u, depth = 0u;
+        for (auto *curr = node, *parent = this->parent_node(node); parent != nullptr; curr = parent, parent = this->parent_node(curr))
+            bits |= static_cast<unsigned>(parent->m_right == curr) << depth++;
+        return (1u << depth) | bits;
+    }
+
+
+    // Returns the position of the first node in level order satisfying pred; in a complete tree the breadth-first
+    // visit order is the level order, so the position is a running count
+    template <Comparable Tp>
+    template <typename Pred>
+    constexpr unsigned max_heap<Tp>::search(Pred pred) const
+    {
+        auto position = 0u;
+        auto q { std::queue<const bitree_node*>{} };
+        if (this->m_root != nullptr)
+            q.push(this->m_root);
+
+        while (!q.empty())
+        {
+            const auto *curr = q.front();
+            q.pop();
+
+            position++;
+            if (pred(*curr))
+                return position;
+
+            if (curr->m_left != nullptr)
+                q.push(curr->m_left);
+            if (curr->m_right != nullptr)
+                q.push(curr->m_right);
+        }
+        return 0;
+    }
+
+
 }   // namespace nonlinear::tree
 
 #endif //DS_GRAPH_MAX_HEAP_H
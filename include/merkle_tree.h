@@ -0,0 +1,186 @@
+#ifndef DS_GRAPH_MERKLE_TREE_H
+#define DS_GRAPH_MERKLE_TREE_H
+
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "avl_tree.h"
+
+
+namespace dsl::nonlinear::tree
+{
+    namespace details
+    {
+        template <Comparable Tp> requires Hashable<Tp>
+        struct merkle_node : public avl_node<Tp>
+        {
+            // Hash of an empty subtree
+            static constexpr const std::size_t empty_hash = 0;
+
+            constexpr explicit merkle_node(const Tp &value) noexcept
+                : avl_node<Tp>(value),
+                  m_hash(digest(value, empty_hash, empty_hash)) {}
+
+            constexpr explicit merkle_node(Tp &&value) noexcept(std::is_nothrow_move_constructible_v<Tp>)
+                : avl_node<Tp>(std::move(value)),
+                  m_hash(digest(this->m_value, empty_hash, empty_hash)) {}
+
+            ~merkle_node() noexcept = default;
+
+            [[nodiscard]] std::size_t footprint() const noexcept override
+            { return sizeof(merkle_node); }
+
+            [[nodiscard]] bitree_node<Tp>* clone_into(void *const where) const override
+            { return this->copy_of(*this, where); }
+
+            // Hash of a node from its value and the hashes of its subtrees; left and right are not interchangeable
+            [[nodiscard]] static constexpr std::size_t digest(const Tp &value, const std::size_t left, const std::size_t right) noexcept
+            { return hash_combine(hash_combine(std::hash<Tp>{}(value), left), right); }
+
+            std::size_t m_hash;     // hash of the values and shape of the subtree rooted here
+
+        };  // struct merkle_node
+
+    }   // namespace details
+
+
+
+    // AVL tree whose nodes cache a hash of their subtree, kept current on every push, pop and rotation
+    // Trees with different hashes are unequal, so replicas that have diverged are told apart in O(1)
+    template <Comparable Tp> requires Hashable<Tp>
+    class merkle_tree : public avl_tree<Tp>
+    {
+    public:
+        using bitree_node = typename avl_tree<Tp>::bitree_node;
+        using merkle_node = typename details::merkle_node<Tp>;
+
+
+        //****** Member Functions ******//
+
+        // No-throw constructor
+        merkle_tree() noexcept
+            : avl_tree<Tp>() {}
+
+        // Copy constructor
+        merkle_tree(const merkle_tree &rhs)
+            : avl_tree<Tp>(rhs) {}
+
+        // Move constructor
+        merkle_tree(merkle_tree &&rhs) noexcept
+            : avl_tree<Tp>(std::move(rhs)) {}
+
+        // Pass-by-value copy/move assignment
+        merkle_tree& operator=(merkle_tree rhs) noexcept
+        { avl_tree<Tp>::operator=(std::move(rhs)); return *this; }
+
+        ~merkle_tree() = default;
+
+        // Builds a balanced tree in O(n) from a sorted range of unique keys
+        template <std::random_access_iterator It>
+        [[nodiscard]] static merkle_tree from_sorted(It first, It last)
+        { merkle_tree t; t.assign_sorted(first, last, false); return t; }
+
+        // As from_sorted, building the left and right subtrees of large ranges concurrently
+        template <std::random_access_iterator It>
+        [[nodiscard]] static merkle_tree from_sorted_parallel(It first, It last)
+        { merkle_tree t; t.assign_sorted(first, last, true); return t; }
+
+
+        //****** Access ******//
+        [[nodiscard]] constexpr std::size_t hash() const noexcept     { return hash_of(this->m_root); }
+
+        [[nodiscard]] static constexpr std::size_t hash_of(const bitree_node *const node) noexcept
+        { return (node == nullptr) ? merkle_node::empty_hash : static_cast<const merkle_node*>(node)->m_hash; }
+
+
+        //****** Set Operations ******//
+        // Restricted to merkle trees, so every node linked in carries a hash
+        [[nodiscard]] merkle_tree split(const Tp&);
+        void join(merkle_tree rhs)              { avl_tree<Tp>::join(std::move(rhs)); }
+        void union_with(merkle_tree rhs)        { avl_tree<Tp>::union_with(std::move(rhs)); }
+        void intersect_with(merkle_tree rhs)    { avl_tree<Tp>::intersect_with(std::move(rhs)); }
+        void difference_with(merkle_tree rhs)   { avl_tree<Tp>::difference_with(std::move(rhs)); }
+
+
+        //****** Comparison ******//
+        // Subtrees whose hashes differ are rejected without being walked; matching hashes are confirmed by value
+        // Both the hash and the equality are shape-sensitive: from_sorted({1, 2, 3, 4, 5}) and pushes in the order
+        // 2, 1, 4, 3, 5 hold the same keys but compare unequal. Comparing key sets needs a hash of the key sequence
+        friend constexpr bool operator==(const merkle_tree &lhs, const merkle_tree &rhs)
+        { return lhs.size() == rhs.size() && same(lhs.m_root, rhs.m_root); }
+
+        friend constexpr bool operator!=(const merkle_tree &lhs, const merkle_tree &rhs)
+        { return !(lhs == rhs); }
+
+
+    protected:
+        [[nodiscard]] bitree_node* make_node(const Tp &value) const override
+        { return this->template create_node<merkle_node>(value); }
+
+        [[nodiscard]] bitree_node* make_node(Tp &&value) const override
+        { return this->template create_node<merkle_node>(std::move(value)); }
+
+        constexpr void refresh(bitree_node*) const noexcept override;
+
+
+    private:
+        [[nodiscard]] static constexpr bool same(const bitree_node*, const bitree_node*);
+
+    };  // class merkle_tree
+
+
+
+    //************ Member Function Implementations ************//
+
+
+    // Recomputes the height, size and subtree hash of a node from its children
+    template <Comparable Tp> requires Hashable<Tp>
+    constexpr void merkle_tree<Tp>::refresh(bitree_node *const node) const noexcept
+    {
+        avl_tree<Tp>::refresh(node);
+        static_cast<merkle_node*>(node)->m_hash =
+                merkle_node::digest(node->m_value, hash_of(node->m_left), hash_of(node->m_right));
+    }
+
+
+    // Splits off and returns the keys greater than or equal to value
+    template <Comparable Tp> requires Hashable<Tp>
+    merkle_tree<Tp> merkle_tree<Tp>::split(const Tp &value)
+    {
+        auto result = merkle_tree{};
+        static_cast<avl_tree<Tp>&>(result) = avl_tree<Tp>::split(value);
+        return result;
+    }
+
+
+    // operator== helper function; shared subtrees are skipped by identity
+    template <Comparable Tp> requires Hashable<Tp>
+    constexpr bool merkle_tree<Tp>::same(const bitree_node *const lroot, const bitree_node *const rroot)
+    {
+        auto s { details::node_stack<std::pair<const bitree_node*, const bitree_node*>>{} };
+        s.push({lroot, rroot});
+
+        while (!s.empty())
+        {
+            auto [lhs, rhs] = s.top();
+            s.pop();
+
+            if (lhs == rhs)
+                continue;
+            if (lhs == nullptr || rhs == nullptr || hash_of(lhs) != hash_of(rhs) || lhs->m_value != rhs->m_value)
+                return false;
+
+            s.push({lhs->m_right, rhs->m_right});
+            s.push({lhs->m_left, rhs->m_left});
+        }
+        return true;
+    }
+
+}   // namespace nonlinear::tree
+
+
+#endif //DS_GRAPH_MERKLE_TREE_H
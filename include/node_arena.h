@@ -0,0 +1,346 @@
+#ifndef DS_GRAPH_NODE_ARENA_H
+#define DS_GRAPH_NODE_ARENA_H
+
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+
+namespace dsl::nonlinear
+{
+    // One allocation carved into equal slots for a known number of nodes, e.g. every node of a tree being copied
+    // The block is a run of chunk_size-aligned chunks that each begin with a pointer to the arena, so a slot's arena
+    // is found from its address alone. Slots are released one by one (from any thread); the block is freed with the last
+    // once the arena is sealed, and until then released slots go on a free list to be handed out again
+    class node_arena
+    {
+    public:
+        static constexpr const std::size_t chunk_size = std::size_t{1} << 16;
+
+
+        //****** Member Functions ******//
+
+        node_arena(const node_arena&) = delete;
+        node_arena& operator=(const node_arena&) = delete;
+
+        // Reserves count slots of slot_size bytes; returns nullptr if there is nothing to reserve, a slot cannot fit a chunk,
+        // or it cannot hold a free list link
+        [[nodiscard]] static node_arena* create(std::size_t, std::size_t);
+
+
+        //****** Modifiers ******//
+        // Hands out a released slot if there is one, else the next unused slot, or nullptr once all are taken
+        // Only the creating thread may allocate
+        [[nodiscard]] void* allocate() noexcept;
+
+        // Ends allocation; the block is freed now if no slot is in use, otherwise when the last one is released
+        void seal() noexcept;
+
+        // Returns a slot handed out by some arena
+        static void release(void*) noexcept;
+
+
+    private:
+        friend class node_slab;
+
+        // Keeps the live count off zero while slots are still being handed out (and possibly released again)
+        static constexpr const std::int64_t unsealed_bias = std::int64_t{1} << 62;
+
+        node_arena *m_self;             // first member: chunk 0 starts with a pointer to the arena like every other chunk
+        std::atomic<std::int64_t> m_live {unsealed_bias};
+        std::size_t m_chunks;
+        std::size_t m_slot_size;
+        std::size_t m_header;           // bytes reserved at the start of each chunk, a multiple of the slot alignment
+        std::size_t m_per_chunk;        // slots in each chunk
+        std::size_t m_chunk = 0, m_slot = 0;
+        std::int64_t m_used = 0;        // slots handed out, reused ones included
+        node_arena *m_next = nullptr;   // next arena of the slab holding this one, if any
+        void *m_local = nullptr;        // released slots taken over by the allocating thread, linked through their first word
+        std::atomic<void*> m_free {nullptr};    // slots released since, pushed by any thread
+
+        node_arena(std::size_t, std::size_t, std::size_t, std::size_t) noexcept;
+        void free() noexcept;
+
+        // Only meaningful to the allocating thread, and only before the arena is sealed
+        [[nodiscard]] bool has_free() const noexcept
+        { return m_local != nullptr || m_free.load(std::memory_order_relaxed) != nullptr; }
+
+        [[nodiscard]] bool released_all() const noexcept
+        { return m_live.load(std::memory_order_acquire) == unsealed_bias - m_used; }
+
+    };  // class node_arena
+
+
+
+    // Growing chain of arenas that one owner (e.g. a tree) carves equal slots from, each arena twice the size of the last
+    // Released slots are handed out again before any arena grows the chain, and arenas whose slots have all been released
+    // are freed when the current one runs dry. The owner may instead free every block at once when it knows that no
+    // slot still holds an object in use elsewhere or one that needs destroying
+    class node_slab
+    {
+    public:
+        static constexpr const std::size_t initial_slots = 64;
+        static constexpr const std::size_t max_slots = std::size_t{1} << 20;
+
+
+        //****** Member Functions ******//
+
+        // No-throw constructor
+        node_slab() noexcept = default;
+
+        node_slab(const node_slab&) = delete;
+        node_slab& operator=(const node_slab&) = delete;
+
+        // Seals every arena; each block is freed once its last slot is released
+        ~node_slab()    { reset(); }
+
+
+        //****** Modifiers ******//
+        // Hands out a slot of slot_size bytes, adding an arena only when no arena has one free; returns nullptr if
+        // slot_size differs from that of the current arena or cannot fit a chunk. Only one thread may allocate at a time
+        [[nodiscard]] void* allocate(std::size_t);
+
+        // Takes over an unsealed arena, e.g. one sized for a whole copy, and allocates from it next
+        void adopt(node_arena*) noexcept;
+
+        // Takes over every arena of another slab, leaving it empty
+        void splice(node_slab&) noexcept;
+
+        // Seals and forgets every arena; slots still in use keep their block alive until they are released
+        void reset() noexcept;
+
+        // Frees every block outright, whatever slots are still in use; their objects are never destroyed
+        void free_all() noexcept;
+
+
+    private:
+        node_arena *m_head = nullptr;   // arena being allocated from; the rest follow through m_next
+        std::size_t m_next_slots = initial_slots;
+
+        [[nodiscard]] bool recycle() noexcept;
+
+    };  // class node_slab
+
+
+
+    //************ Member Function Implementations ************//
+
+
+    // Private constructor; placed at the start of the block by create
+    inline node_arena::node_arena(const std::size_t chunks, const std::size_t slot_size,
+                                  const std::size_t header, const std::size_t per_chunk) noexcept
+        : m_self(this),
+          m_chunks(chunks),
+          m_slot_size(slot_size),
+          m_header(header),
+          m_per_chunk(per_chunk) {}
+
+
+    // Allocates the block with one call and writes the arena pointer at the start of every chunk
+    inline node_arena* node_arena::create(const std::size_t count, const std::size_t slot_size)
+    {
+        if (count == 0 || slot_size == 0)
+            return nullptr;
+
+        // sizeof is a multiple of alignof, so its lowest set bit is an alignment every slot can keep
+        const auto align = std::max<std::size_t>(alignof(node_arena), slot_size & (~slot_size + 1));
+        const auto header = (sizeof(node_arena) + align - 1) / align * align;
+        if (header + slot_size > chunk_size || slot_size < sizeof(void*) || slot_size % alignof(void*) != 0)
+            return nullptr;
+
+        const auto per_chunk = (chunk_size - header) / slot_size;
+        const auto chunks = (count + per_chunk - 1) / per_chunk;
+        auto *block = static_cast<std::byte*>(::operator new(chunks * chunk_size, std::align_val_t{chunk_size}));
+
+        auto *arena = ::new (static_cast<void*>(block)) node_arena(chunks, slot_size, header, per_chunk);
+        for (auto i = std::size_t{1}; i < chunks; i++)
+            ::new (static_cast<void*>(block + i * chunk_size)) node_arena*(arena);
+        return arena;
+    }
+
+
+    // Pops the local free list, refilling it from the shared one when it runs out, and otherwise bumps the cursor
+    // through each chunk in turn. Only this thread pops, so a slot cannot leave and return to the shared list unseen
+    inline void* node_arena::allocate() noexcept
+    {
+        if (m_local == nullptr && m_free.load(std::memory_order_relaxed) != nullptr)
+            m_local = m_free.exchange(nullptr, std::memory_order_acquire);
+
+        if (m_local != nullptr)
+        {
+            auto *slot = m_local;
+            m_local = *static_cast<void**>(slot);
+            m_used++;
+            return slot;
+        }
+
+        if (m_slot == m_per_chunk)
+        {
+            if (m_chunk + 1 == m_chunks)
+                return nullptr;
+            m_chunk++;
+            m_slot = 0;
+        }
+
+        auto *slot = reinterpret_cast<std::byte*>(this) + m_chunk * chunk_size + m_header + m_slot * m_slot_size;
+        m_slot++;
+        m_used++;
+        return slot;
+    }
+
+
+    // Swaps the bias for the number of slots handed out; releases that already happened have been counted against it
+    inline void node_arena::seal() noexcept
+    {
+        const auto drop = unsealed_bias - m_used;
+        if (m_live.fetch_sub(drop, std::memory_order_acq_rel) == drop)
+            free();
+    }
+
+
+    // Masks the address down to its chunk to find the arena; the slot is pushed for reuse before it is counted as
+    // released, so nothing touches the arena after the count that may let it be freed
+    inline void node_arena::release(void *const slot) noexcept
+    {
+        const auto chunk = reinterpret_cast<std::uintptr_t>(slot) & ~(chunk_size - 1);
+        auto *arena = *reinterpret_cast<node_arena**>(chunk);
+
+        // A sealed arena hands out nothing more; its count sits far below the bias
+        if (arena->m_live.load(std::memory_order_relaxed) > unsealed_bias / 2)
+        {
+            auto *head = arena->m_free.load(std::memory_order_relaxed);
+            do { *static_cast<void**>(slot) = head; }
+            while (!arena->m_free.compare_exchange_weak(head, slot, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        if (arena->m_live.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            arena->free();
+    }
+
+
+    // Frees the block holding the arena and all its slots
+    inline void node_arena::free() noexcept
+    {
+        this->~node_arena();
+        ::operator delete(static_cast<void*>(this), std::align_val_t{chunk_size});
+    }
+
+
+
+    // Allocates from the current arena, then from the first other arena with a released slot, and only then from a new one
+    inline void* node_slab::allocate(const std::size_t slot_size)
+    {
+        if (m_head != nullptr)
+        {
+            if (m_head->m_slot_size != slot_size)
+                return nullptr;
+            if (auto *slot = m_head->allocate(); slot != nullptr)
+                return slot;
+            if (recycle())
+                return m_head->allocate();
+        }
+
+        auto *arena = node_arena::create(m_next_slots, slot_size);
+        if (arena == nullptr)
+            return nullptr;
+
+        adopt(arena);
+        m_next_slots = std::min(2 * m_next_slots, max_slots);
+        return arena->allocate();
+    }
+
+
+    // Called once the current arena has run dry: frees every other arena whose slots have all been released, and moves
+    // the first one with a released slot to the head. The scan is over O(log n) arenas, since each doubles the last
+    // No slot of a fully released arena is held, so no other thread can be releasing into it as it is freed
+    inline bool node_slab::recycle() noexcept
+    {
+        node_arena *found = nullptr;
+        for (auto **link = &m_head->m_next; *link != nullptr;)
+        {
+            auto *arena = *link;
+            if (found == nullptr && arena->m_slot_size == m_head->m_slot_size && arena->has_free())
+            {
+                *link = arena->m_next;
+                found = arena;
+            }
+            else if (arena->released_all())
+            {
+                *link = arena->m_next;
+                arena->free();
+            }
+            else
+                link = &arena->m_next;
+        }
+
+        if (found == nullptr)
+            return false;
+
+        found->m_next = m_head;
+        m_head = found;
+        return true;
+    }
+
+
+    inline void node_slab::adopt(node_arena *const arena) noexcept
+    {
+        arena->m_next = m_head;
+        m_head = arena;
+    }
+
+
+    // Links the other chain in behind the current arena, so allocation carries on where it was
+    inline void node_slab::splice(node_slab &rhs) noexcept
+    {
+        if (rhs.m_head == nullptr)
+            return;
+
+        if (m_head == nullptr)
+        {
+            m_head = rhs.m_head;
+            m_next_slots = rhs.m_next_slots;
+        }
+        else
+        {
+            auto *tail = rhs.m_head;
+            while (tail->m_next != nullptr)
+                tail = tail->m_next;
+            tail->m_next = m_head->m_next;
+            m_head->m_next = rhs.m_head;
+        }
+
+        rhs.m_head = nullptr;
+        rhs.m_next_slots = initial_slots;
+    }
+
+
+    inline void node_slab::reset() noexcept
+    {
+        while (m_head != nullptr)
+        {
+            auto *next = m_head->m_next;
+            m_head->seal();
+            m_head = next;
+        }
+        m_next_slots = initial_slots;
+    }
+
+
+    inline void node_slab::free_all() noexcept
+    {
+        while (m_head != nullptr)
+        {
+            auto *next = m_head->m_next;
+            m_head->free();
+            m_head = next;
+        }
+        m_next_slots = initial_slots;
+    }
+
+}   // namespace nonlinear
+
+
+#endif //DS_GRAPH_NODE_ARENA_H
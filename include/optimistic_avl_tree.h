@@ -0,0 +1,364 @@
+#ifndef DS_GRAPH_OPTIMISTIC_AVL_TREE_H
+#define DS_GRAPH_OPTIMISTIC_AVL_TREE_H
+
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "epoch.h"
+#include "traits.h"
+
+
+namespace dsl::nonlinear::tree
+{
+    namespace details
+    {
+        // A node's version changes whenever the range of keys reachable through it shrinks (it is rotated down)
+        // or it is unlinked; readers that validated an older version retry from the level above
+        template <Comparable Tp>
+        struct optimistic_node
+        {
+            static constexpr const std::uint64_t unlinked = 1, shrinking = 2, increment = 4;
+
+            explicit optimistic_node(const Tp &value)
+                : m_value(value) {}
+
+            explicit optimistic_node(Tp &&value) noexcept(std::is_nothrow_move_constructible_v<Tp>)
+                : m_value(std::move(value)) {}
+
+            [[nodiscard]] std::atomic<optimistic_node*>& child(const bool right) noexcept
+            { return right ? m_right : m_left; }
+
+            const Tp m_value;
+            std::atomic<optimistic_node*> m_left {nullptr}, m_right {nullptr};
+            std::atomic<std::uint64_t> m_version {0};
+            std::atomic<bool> m_present {true};     // false for a routing node whose key has been popped
+            int m_height = 1;                       // touched by the writer only
+
+        };  // struct optimistic_node
+
+    }   // namespace details
+
+
+
+    // Concurrent AVL tree for read-mostly workloads, after Bronson et al.'s optimistic tree
+    // Readers descend hand over hand, validating each node's version instead of locking, so they never block
+    // one another or write to the tree. Writers are serialized and retire unlinked nodes through the epoch domain
+    template <Comparable Tp> requires std::default_initializable<Tp>
+    class optimistic_avl_tree
+    {
+    public:
+        using optimistic_node = typename details::optimistic_node<Tp>;
+
+
+        //****** Member Functions ******//
+
+        optimistic_avl_tree()
+            : m_holder(new optimistic_node(Tp{})) {}
+
+        optimistic_avl_tree(const optimistic_avl_tree&) = delete;
+        optimistic_avl_tree& operator=(const optimistic_avl_tree&) = delete;
+
+        // Not safe to run concurrently with any other operation on the tree
+        ~optimistic_avl_tree();
+
+
+        //****** Access ******//
+        [[nodiscard]] int size() const noexcept     { return m_size.load(std::memory_order_relaxed); }
+        [[nodiscard]] bool empty() const noexcept   { return size() == 0; }
+
+        [[nodiscard]] bool contains(const Tp&) const;
+        [[nodiscard]] std::optional<Tp> find(const Tp&) const;     // a copy; the node may be reclaimed afterwards
+
+
+        //****** Modifiers ******//
+        bool push(const Tp &value)  { return insert(value); }
+        bool push(Tp &&value)       { return insert(std::move(value)); }
+        bool pop(const Tp&);
+
+        // Builds the value from args once and moves it into its node
+        template <typename... Args> requires std::constructible_from<Tp, Args...>
+        bool emplace(Args &&...args)
+        { return push(Tp(std::forward<Args>(args)...)); }
+
+
+    private:
+        enum class outcome { absent, found, retry };
+
+        optimistic_node *m_holder;      // root holder; its right child is the root and its version never changes
+        std::atomic<int> m_size {0};
+        std::mutex m_writer;
+
+        [[nodiscard]] static int height(const optimistic_node *const node) noexcept
+        { return (node == nullptr) ? 0 : node->m_height; }
+
+        outcome attempt_find(const Tp&, optimistic_node*, bool, std::uint64_t, const optimistic_node*&) const;
+        [[nodiscard]] std::vector<optimistic_node*> path_to(const Tp&) const;
+
+        template <typename Vp>
+        bool insert(Vp&&);
+
+        void rebalance(const std::vector<optimistic_node*>&);
+        static void refresh(optimistic_node*) noexcept;
+        static void rotate(optimistic_node*, bool, bool) noexcept;
+        static void unlink(optimistic_node*, bool, optimistic_node*);
+
+    };  // class optimistic_avl_tree
+
+
+
+    //************ Member Function Implementations ************//
+
+
+    // Destructor
+    template <Comparable Tp> requires std::default_initializable<Tp>
+    optimistic_avl_tree<Tp>::~optimistic_avl_tree()
+    {
+        auto s { std::vector<optimistic_node*>{m_holder} };
+        while (!s.empty())
+        {
+            auto *curr = s.back();
+            s.pop_back();
+
+            if (auto *left = curr->m_left.load(std::memory_order_relaxed); left != nullptr)
+                s.push_back(left);
+            if (auto *right = curr->m_right.load(std::memory_order_relaxed); right != nullptr)
+                s.push_back(right);
+            delete curr;
+        }
+        m_holder = nullptr;
+    }
+
+
+    // Checks if the value is in the set
+    template <Comparable Tp> requires std::default_initializable<Tp>
+    bool optimistic_avl_tree<Tp>::contains(const Tp &value) const
+    {
+        auto guard = epoch_domain::shared().pin();
+        const optimistic_node *node = nullptr;
+        while (true)
+        {
+            const auto result = attempt_find(value, m_holder, true, 0, node);
+            if (result != outcome::retry)
+                return result == outcome::found;
+        }
+    }
+
+
+    // Returns a copy of the stored value equal to value, if it exists
+    template <Comparable Tp> requires std::default_initializable<Tp>
+    std::optional<Tp> optimistic_avl_tree<Tp>::find(const Tp &value) const
+    {
+        auto guard = epoch_domain::shared().pin();
+        const optimistic_node *node = nullptr;
+        while (true)
+        {
+            const auto result = attempt_find(value, m_holder, true, 0, node);
+            if (result != outcome::retry)
+                return (result == outcome::found) ? std::optional<Tp>(node->m_value) : std::nullopt;
+        }
+    }
+
+
+    // Searches below node, whose version was nodeV when it was reached; fails with retry if node has since
+    // shrunk or been unlinked, so the caller can revalidate its own node and try again from there
+    template <Comparable Tp> requires std::default_initializable<Tp>
+    typename optimistic_avl_tree<Tp>::outcome
+    optimistic_avl_tree<Tp>::attempt_find(const Tp &value, optimistic_node *const node, const bool right,
+                                          const std::uint64_t nodeV, const optimistic_node *&found) const
+    {
+        while (true)
+        {
+            auto *child = node->child(right).load(std::memory_order_acquire);
+            if (child == nullptr)
+                return (node->m_version.load(std::memory_order_acquire) == nodeV) ? outcome::absent : outcome::retry;
+
+            // A key never moves between nodes, so a match needs no further validation
+            if (value == child->m_value)
+            {
+                found = child;
+                return child->m_present.load(std::memory_order_acquire) ? outcome::found : outcome::absent;
+            }
+
+            const auto childV = child->m_version.load(std::memory_order_acquire);
+            if (childV & (optimistic_node::shrinking | optimistic_node::unlinked))
+            {
+                // A rotation is moving child down; wait it out, then re-read the link if node is still valid
+                while (child->m_version.load(std::memory_order_acquire) & optimistic_node::shrinking)
+                    std::this_thread::yield();
+            }
+            else if (child == node->child(right).load(std::memory_order_acquire) &&
+                     node->m_version.load(std::memory_order_acquire) == nodeV)
+            {
+                // Hand over hand: child was validated while node still was, so its range covers value
+                const auto result = attempt_find(value, child, !(value < child->m_value), childV, found);
+                if (result != outcome::retry)
+                    return result;
+            }
+
+            if (node->m_version.load(std::memory_order_acquire) != nodeV)
+                return outcome::retry;
+        }
+    }
+
+
+    // Returns the writer's search path for value: the holder, then every node down to value or a null link
+    template <Comparable Tp> requires std::default_initializable<Tp>
+    std::vector<typename optimistic_avl_tree<Tp>::optimistic_node*>
+    optimistic_avl_tree<Tp>::path_to(const Tp &value) const
+    {
+        auto path { std::vector<optimistic_node*>{m_holder} };
+        auto *curr = m_holder->m_right.load(std::memory_order_relaxed);
+        while (curr != nullptr)
+        {
+            path.push_back(curr);
+            if (value == curr->m_value)
+                break;
+            curr = curr->child(!(value < curr->m_value)).load(std::memory_order_relaxed);
+        }
+        return path;
+    }
+
+
+    // Inserts a value as a new leaf, or revives the routing node that still holds its key
+    // The value is forwarded into a node only when a new leaf is needed
+    template <Comparable Tp> requires std::default_initializable<Tp>
+    template <typename Vp>
+    bool optimistic_avl_tree<Tp>::insert(Vp &&value)
+    {
+        auto lock = std::lock_guard{m_writer};
+        auto guard = epoch_domain::shared().pin();
+
+        auto path = path_to(value);
+        auto *last = path.back();
+        if (last != m_holder && last->m_value == value)
+        {
+            if (last->m_present.load(std::memory_order_relaxed))
+                return false;
+            last->m_present.store(true, std::memory_order_release);
+            m_size.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        const auto right = (last == m_holder) || !(value < last->m_value);
+        last->child(right).store(new optimistic_node(std::forward<Vp>(value)), std::memory_order_release);
+        m_size.fetch_add(1, std::memory_order_relaxed);
+
+        rebalance(path);
+        return true;
+    }
+
+
+    // Removes a value: its node becomes a routing node, unlinked as soon as it has fewer than two children
+    template <Comparable Tp> requires std::default_initializable<Tp>
+    bool optimistic_avl_tree<Tp>::pop(const Tp &value)
+    {
+        auto lock = std::lock_guard{m_writer};
+        auto guard = epoch_domain::shared().pin();
+
+        auto path = path_to(value);
+        auto *last = path.back();
+        if (last == m_holder || last->m_value != value || !last->m_present.load(std::memory_order_relaxed))
+            return false;
+
+        last->m_present.store(false, std::memory_order_release);
+        m_size.fetch_sub(1, std::memory_order_relaxed);
+
+        rebalance(path);
+        return true;
+    }
+
+
+    // Walks the path bottom-up, unlinking childless or single-child routing nodes and restoring AVL balance
+    template <Comparable Tp> requires std::default_initializable<Tp>
+    void optimistic_avl_tree<Tp>::rebalance(const std::vector<optimistic_node*> &path)
+    {
+        for (auto i = static_cast<int>(path.size()) - 1; i > 0; i--)
+        {
+            auto *node = path[i], *parent = path[i - 1];
+            const auto right = parent->m_right.load(std::memory_order_relaxed) == node;
+            auto *left_child = node->m_left.load(std::memory_order_relaxed);
+            auto *right_child = node->m_right.load(std::memory_order_relaxed);
+
+            if (!node->m_present.load(std::memory_order_relaxed) && (left_child == nullptr || right_child == nullptr))
+            {
+                unlink(parent, right, node);
+                continue;
+            }
+
+            refresh(node);
+            const auto balance = height(left_child) - height(right_child);
+            if (balance > 1)
+            {
+                if (height(left_child->m_left.load(std::memory_order_relaxed)) <
+                    height(left_child->m_right.load(std::memory_order_relaxed)))
+                    rotate(node, false, false);
+                rotate(parent, right, true);
+            }
+            else if (balance < -1)
+            {
+                if (height(right_child->m_right.load(std::memory_order_relaxed)) <
+                    height(right_child->m_left.load(std::memory_order_relaxed)))
+                    rotate(node, true, true);
+                rotate(parent, right, false);
+            }
+        }
+    }
+
+
+    // Recomputes a node's height from its children
+    template <Comparable Tp> requires std::default_initializable<Tp>
+    void optimistic_avl_tree<Tp>::refresh(optimistic_node *const node) noexcept
+    {
+        node->m_height = 1 + std::max(height(node->m_left.load(std::memory_order_relaxed)),
+                                      height(node->m_right.load(std::memory_order_relaxed)));
+    }
+
+
+    // Rotates the child of parent on the given side to the right (or left), lifting its left (or right) child
+    // The node moving down is marked shrinking for the duration, so readers below it revalidate
+    template <Comparable Tp> requires std::default_initializable<Tp>
+    void optimistic_avl_tree<Tp>::rotate(optimistic_node *const parent, const bool side, const bool to_right) noexcept
+    {
+        auto *node = parent->child(side).load(std::memory_order_relaxed);
+        auto *pivot = node->child(!to_right).load(std::memory_order_relaxed);
+        auto *inner = pivot->child(to_right).load(std::memory_order_relaxed);
+
+        const auto version = node->m_version.load(std::memory_order_relaxed);
+        node->m_version.store(version | optimistic_node::shrinking, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        node->child(!to_right).store(inner, std::memory_order_release);
+        pivot->child(to_right).store(node, std::memory_order_release);
+        parent->child(side).store(pivot, std::memory_order_release);
+
+        refresh(node);
+        refresh(pivot);
+        node->m_version.store(version + optimistic_node::increment, std::memory_order_release);
+    }
+
+
+    // Splices out a node with at most one child and retires it
+    template <Comparable Tp> requires std::default_initializable<Tp>
+    void optimistic_avl_tree<Tp>::unlink(optimistic_node *const parent, const bool side, optimistic_node *const node)
+    {
+        auto *left = node->m_left.load(std::memory_order_relaxed);
+        parent->child(side).store((left != nullptr) ? left : node->m_right.load(std::memory_order_relaxed),
+                                  std::memory_order_release);
+        node->m_version.store(node->m_version.load(std::memory_order_relaxed) | optimistic_node::unlinked,
+                              std::memory_order_release);
+        epoch_domain::shared().retire(node);
+    }
+
+}   // namespace nonlinear::tree
+
+
+#endif //DS_GRAPH_OPTIMISTIC_AVL_TREE_H
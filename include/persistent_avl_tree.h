@@ -0,0 +1,442 @@
+#ifndef DS_GRAPH_PERSISTENT_AVL_TREE_H
+#define DS_GRAPH_PERSISTENT_AVL_TREE_H
+
+
+#include <algorithm>
+#include <concepts>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "bitree_node.h"
+
+
+namespace dsl::nonlinear::tree
+{
+    namespace details
+    {
+        // Immutable once built; children are shared by reference count between every version that reaches them
+        template <Comparable Tp>
+        struct persistent_node
+        {
+            using node_ptr = std::shared_ptr<const persistent_node>;
+
+            persistent_node(const Tp &value, node_ptr left, node_ptr right)
+                : m_value(value),
+                  m_left(std::move(left)),
+                  m_right(std::move(right)),
+                  m_height(1 + std::max(height(m_left), height(m_right))),
+                  m_count(1 + count(m_left) + count(m_right)) {}
+
+            persistent_node(Tp &&value, node_ptr left, node_ptr right)
+                : m_value(std::move(value)),
+                  m_left(std::move(left)),
+                  m_right(std::move(right)),
+                  m_height(1 + std::max(height(m_left), height(m_right))),
+                  m_count(1 + count(m_left) + count(m_right)) {}
+
+            [[nodiscard]] static int height(const node_ptr &node) noexcept  { return (node == nullptr) ? 0 : node->m_height; }
+            [[nodiscard]] static int count(const node_ptr &node) noexcept   { return (node == nullptr) ? 0 : node->m_count; }
+
+            const Tp m_value;
+            const node_ptr m_left, m_right;
+            const int m_height;     // levels in the subtree rooted here (a leaf has height 1)
+            const int m_count;      // nodes in the subtree rooted here
+
+        };  // struct persistent_node
+
+    }   // namespace details
+
+
+
+    // AVL tree with path copying: an update copies only the O(log n) nodes on its search path and shares the rest,
+    // so copies and snapshots are O(1) and a version never changes once taken
+    // One writer per tree object; a snapshot may then be handed to and read from any thread while the writer continues
+    // Keys are ordered by the Compare policy, which makes one three-way comparison per node visited
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare = three_way_compare>
+    class persistent_avl_tree
+    {
+    public:
+        using persistent_node = typename details::persistent_node<Tp>;
+        using node_ptr = typename persistent_node::node_ptr;
+
+
+        //****** Member Functions ******//
+
+        // No-throw constructor
+        persistent_avl_tree() noexcept = default;
+
+        // Copy constructor; shares every node in O(1)
+        persistent_avl_tree(const persistent_avl_tree&) noexcept = default;
+
+        // Move constructor
+        persistent_avl_tree(persistent_avl_tree &&rhs) noexcept
+            : persistent_avl_tree()
+        { swap(rhs); }
+
+        // Pass-by-value copy/move assignment
+        persistent_avl_tree& operator=(persistent_avl_tree rhs) noexcept
+        { swap(rhs); return *this; }
+
+        ~persistent_avl_tree() = default;
+        void swap(persistent_avl_tree &rhs) noexcept;
+
+        // Returns the current version in O(1); later updates to this tree leave it untouched
+        [[nodiscard]] persistent_avl_tree snapshot() const noexcept  { return *this; }
+
+
+        //****** Access ******//
+        [[nodiscard]] const node_ptr& root() const noexcept   { return m_root; }
+        [[nodiscard]] int size() const noexcept               { return persistent_node::count(m_root); }
+        [[nodiscard]] bool empty() const noexcept             { return m_root == nullptr; }
+        [[nodiscard]] int depth() const noexcept              { return persistent_node::height(m_root); }
+
+        // Lookups accept any key the Compare policy orders against Tp, compared without conversion
+        template <typename Kp = Tp> requires ThreeWayComparator<Compare, Kp, Tp>
+        [[nodiscard]] const Tp* find(const Kp&) const noexcept;
+
+        template <typename Kp = Tp> requires ThreeWayComparator<Compare, Kp, Tp>
+        [[nodiscard]] bool contains(const Kp &value) const noexcept   { return descend(value) != nullptr; }
+
+        [[nodiscard]] const Tp& select(int) const;     // throws if index is out of range
+        template <typename Kp = Tp> requires ThreeWayComparator<Compare, Kp, Tp>
+        [[nodiscard]] int rank(const Kp&) const noexcept;
+
+        template <std::invocable<const Tp&> Fn>
+        void for_each(Fn&&) const;
+
+
+        //****** Modifiers ******//
+        bool push(const Tp&);
+        bool push(Tp&&);
+        bool pop(const Tp&);
+
+        // Builds the value from args once and moves it into its node
+        template <typename... Args> requires std::constructible_from<Tp, Args...>
+        bool emplace(Args &&...args)
+        { return push(Tp(std::forward<Args>(args)...)); }
+
+
+    private:
+        node_ptr m_root;
+
+        template <typename Kp>
+        [[nodiscard]] static constexpr auto compare(const Kp &key, const Tp &value)
+        { return Compare{}(key, value); }
+
+        template <typename Kp>
+        [[nodiscard]] const persistent_node* descend(const Kp&) const noexcept;
+
+        [[nodiscard]] static node_ptr balance(const Tp&, node_ptr, node_ptr);
+        template <typename Vp>
+        [[nodiscard]] static node_ptr insert(const node_ptr&, Vp&&, bool&);
+        [[nodiscard]] static node_ptr erase(const node_ptr&, const Tp&, bool&);
+        [[nodiscard]] static node_ptr erase_min(const node_ptr&, const Tp*&);
+
+    };  // class persistent_avl_tree
+
+
+
+    //************ Member Function Implementations ************//
+
+
+    // Member swap function
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    void persistent_avl_tree<Tp, Compare>::swap(persistent_avl_tree<Tp, Compare> &rhs) noexcept
+    {
+        using std::swap;
+        swap(rhs.m_root, m_root);
+    }
+
+
+    // Returns the stored value equivalent to value, if it exists
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    template <typename Kp> requires ThreeWayComparator<Compare, Kp, Tp>
+    const Tp* persistent_avl_tree<Tp, Compare>::find(const Kp &value) const noexcept
+    {
+        const auto *node = descend(value);
+        return (node == nullptr) ? nullptr : &node->m_value;
+    }
+
+
+    // Walks down to the node holding key on one three-way comparison per level; returns nullptr if the key is absent
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    template <typename Kp>
+    const typename persistent_avl_tree<Tp, Compare>::persistent_node*
+    persistent_avl_tree<Tp, Compare>::descend(const Kp &key) const noexcept
+    {
+        const auto *curr = m_root.get();
+        while (curr != nullptr)
+        {
+            const auto order = compare(key, curr->m_value);
+            if (order == 0)
+                break;
+            curr = (order < 0) ? curr->m_left.get() : curr->m_right.get();
+        }
+        return curr;
+    }
+
+
+    // Returns the value with the given zero-based rank in sorted order, in O(log n)
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    const Tp& persistent_avl_tree<Tp, Compare>::select(int index) const
+    {
+        if (index < 0 || index >= size())
+            throw std::out_of_range("Cannot select an index outside the tree.");
+
+        const auto *curr = m_root.get();
+        while (true)
+        {
+            const auto left = persistent_node::count(curr->m_left);
+            if (index == left)
+                return curr->m_value;
+
+            if (index < left)
+                curr = curr->m_left.get();
+            else
+            {
+                index -= left + 1;
+                curr = curr->m_right.get();
+            }
+        }
+    }
+
+
+    // Returns the number of values less than value, in O(log n)
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    template <typename Kp> requires ThreeWayComparator<Compare, Kp, Tp>
+    int persistent_avl_tree<Tp, Compare>::rank(const Kp &value) const noexcept
+    {
+        auto result = 0;
+        const auto *curr = m_root.get();
+        while (curr != nullptr)
+        {
+            if (compare(value, curr->m_value) > 0)
+            {
+                result += persistent_node::count(curr->m_left) + 1;
+                curr = curr->m_right.get();
+            }
+            else
+                curr = curr->m_left.get();
+        }
+        return result;
+    }
+
+
+    // Visits every value in sorted order
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    template <std::invocable<const Tp&> Fn>
+    void persistent_avl_tree<Tp, Compare>::for_each(Fn &&fn) const
+    {
+        auto s { details::node_stack<const persistent_node*>{} };
+        const auto *curr = m_root.get();
+
+        while (curr != nullptr || !s.empty())
+        {
+            while (curr != nullptr)
+            {
+                s.push(curr);
+                curr = curr->m_left.get();
+            }
+
+            curr = s.top();
+            s.pop();
+            fn(curr->m_value);
+            curr = curr->m_right.get();
+        }
+    }
+
+
+    // Inserts a value, copying only the search path; returns false if it is already present
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    bool persistent_avl_tree<Tp, Compare>::push(const Tp &value)
+    {
+        auto inserted = false;
+        auto root = insert(m_root, value, inserted);
+        if (inserted)
+            m_root = std::move(root);
+        return inserted;
+    }
+
+
+    // As push, moving the value into the new leaf (only if it is inserted)
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    bool persistent_avl_tree<Tp, Compare>::push(Tp &&value)
+    {
+        auto inserted = false;
+        auto root = insert(m_root, std::move(value), inserted);
+        if (inserted)
+            m_root = std::move(root);
+        return inserted;
+    }
+
+
+    // Removes a value, copying only the search path; returns false if it is not present
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    bool persistent_avl_tree<Tp, Compare>::pop(const Tp &value)
+    {
+        auto erased = false;
+        auto root = erase(m_root, value, erased);
+        if (erased)
+            m_root = std::move(root);
+        return erased;
+    }
+
+
+    // Builds a node over two subtrees whose heights differ by at most 2, rotating (by copying) if needed
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    typename persistent_avl_tree<Tp, Compare>::node_ptr
+    persistent_avl_tree<Tp, Compare>::balance(const Tp &value, node_ptr left, node_ptr right)
+    {
+        const auto hl = persistent_node::height(left), hr = persistent_node::height(right);
+
+        if (hl > hr + 1)
+        {
+            if (persistent_node::height(left->m_left) >= persistent_node::height(left->m_right))
+                return std::make_shared<const persistent_node>(left->m_value, left->m_left,
+                        std::make_shared<const persistent_node>(value, left->m_right, std::move(right)));
+
+            const auto &pivot = left->m_right;
+            return std::make_shared<const persistent_node>(pivot->m_value,
+                    std::make_shared<const persistent_node>(left->m_value, left->m_left, pivot->m_left),
+                    std::make_shared<const persistent_node>(value, pivot->m_right, std::move(right)));
+        }
+
+        if (hr > hl + 1)
+        {
+            if (persistent_node::height(right->m_right) >= persistent_node::height(right->m_left))
+                return std::make_shared<const persistent_node>(right->m_value,
+                        std::make_shared<const persistent_node>(value, std::move(left), right->m_left), right->m_right);
+
+            const auto &pivot = right->m_left;
+            return std::make_shared<const persistent_node>(pivot->m_value,
+                    std::make_shared<const persistent_node>(value, std::move(left), pivot->m_left),
+                    std::make_shared<const persistent_node>(right->m_value, pivot->m_right, right->m_right));
+        }
+
+        return std::make_shared<const persistent_node>(value, std::move(left), std::move(right));
+    }
+
+
+    // push helper function; returns the new version of the subtree (the same one if nothing was inserted)
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    template <typename Vp>
+    typename persistent_avl_tree<Tp, Compare>::node_ptr
+    persistent_avl_tree<Tp, Compare>::insert(const node_ptr &root, Vp &&value, bool &inserted)
+    {
+        if (root == nullptr)
+        {
+            inserted = true;
+            return std::make_shared<const persistent_node>(std::forward<Vp>(value), nullptr, nullptr);
+        }
+
+        const auto order = compare(value, root->m_value);
+        if (order == 0)
+            return root;
+
+        if (order < 0)
+        {
+            auto left = insert(root->m_left, std::forward<Vp>(value), inserted);
+            return (inserted) ? balance(root->m_value, std::move(left), root->m_right) : root;
+        }
+
+        auto right = insert(root->m_right, std::forward<Vp>(value), inserted);
+        return (inserted) ? balance(root->m_value, root->m_left, std::move(right)) : root;
+    }
+
+
+    // pop helper function; returns the new version of the subtree (the same one if nothing was erased)
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    typename persistent_avl_tree<Tp, Compare>::node_ptr
+    persistent_avl_tree<Tp, Compare>::erase(const node_ptr &root, const Tp &value, bool &erased)
+    {
+        if (root == nullptr)
+            return nullptr;
+
+        const auto order = compare(value, root->m_value);
+        if (order < 0)
+        {
+            auto left = erase(root->m_left, value, erased);
+            return (erased) ? balance(root->m_value, std::move(left), root->m_right) : root;
+        }
+
+        if (order > 0)
+        {
+            auto right = erase(root->m_right, value, erased);
+            return (erased) ? balance(root->m_value, root->m_left, std::move(right)) : root;
+        }
+
+        erased = true;
+        if (root->m_left == nullptr)
+            return root->m_right;
+        if (root->m_right == nullptr)
+            return root->m_left;
+
+        // Replace the value with its in-order successor
+        const Tp *successor = nullptr;
+        auto right = erase_min(root->m_right, successor);
+        return balance(*successor, root->m_left, std::move(right));
+    }
+
+
+    // Copies the path to the minimum of a subtree without it, pointing min at its (still shared) value
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    typename persistent_avl_tree<Tp, Compare>::node_ptr
+    persistent_avl_tree<Tp, Compare>::erase_min(const node_ptr &root, const Tp *&min)
+    {
+        if (root->m_left == nullptr)
+        {
+            min = &root->m_value;
+            return root->m_right;
+        }
+        return balance(root->m_value, erase_min(root->m_left, min), root->m_right);
+    }
+
+
+    //************ Non-Member Function Implementations ************//
+
+
+    // Versions that share a root are equal without a walk; otherwise both are walked in order in step
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    [[nodiscard]] bool operator==(const persistent_avl_tree<Tp, Compare> &lhs, const persistent_avl_tree<Tp, Compare> &rhs)
+    {
+        using persistent_node = typename persistent_avl_tree<Tp, Compare>::persistent_node;
+
+        if (lhs.root() == rhs.root())
+            return true;
+        if (lhs.size() != rhs.size())
+            return false;
+
+        auto s { details::node_stack<const persistent_node*>{} };
+        const auto *curr = rhs.root().get();
+        auto next = [&s, &curr]() -> const Tp& {
+            while (curr != nullptr)
+            {
+                s.push(curr);
+                curr = curr->m_left.get();
+            }
+            const auto *top = s.top();
+            s.pop();
+            curr = top->m_right.get();
+            return top->m_value;
+        };
+
+        auto same = true;
+        lhs.for_each([&same, &next](const Tp &value) { same = same && Compare{}(value, next()) == 0; });
+        return same;
+    }
+
+
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    [[nodiscard]] bool operator!=(const persistent_avl_tree<Tp, Compare> &lhs, const persistent_avl_tree<Tp, Compare> &rhs)
+    { return !(lhs == rhs); }
+
+
+    template <Comparable Tp, ThreeWayComparator<Tp> Compare>
+    void swap(persistent_avl_tree<Tp, Compare> &lhs, persistent_avl_tree<Tp, Compare> &rhs) noexcept
+    { lhs.swap(rhs); }
+
+}   // namespace nonlinear::tree
+
+
+#endif //DS_GRAPH_PERSISTENT_AVL_TREE_H
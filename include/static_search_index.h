@@ -0,0 +1,210 @@
+#ifndef DS_GRAPH_STATIC_SEARCH_INDEX_H
+#define DS_GRAPH_STATIC_SEARCH_INDEX_H
+
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#include "binary_search_tree.h"
+
+
+namespace dsl::nonlinear::tree
+{
+    // Read-only ordered index; keys are stored in Eytzinger (level) order in one cache-aligned array
+    template <Comparable Tp>
+    class static_search_index
+    {
+    public:
+
+        //****** Member Functions ******//
+
+        // No-throw constructor
+        static_search_index() noexcept
+            : m_keys(nullptr),
+              m_size(0) {}
+
+        // Constructs the index from the keys of a search tree (or any derived tree, e.g. avl_tree)
+        explicit static_search_index(const binary_search_tree<Tp>&);
+
+        // Constructs the index from a sorted range
+        template <std::random_access_iterator It>
+        static_search_index(It, It);
+
+        // Copy constructor
+        static_search_index(const static_search_index&);
+
+        // Move constructor
+        static_search_index(static_search_index &&rhs) noexcept
+            : static_search_index()
+        { swap(rhs); }
+
+        // Pass-by-value copy/move assignment
+        static_search_index& operator=(static_search_index rhs) noexcept
+        { swap(rhs); return *this; }
+
+        ~static_search_index();
+        constexpr void swap(static_search_index &rhs) noexcept;
+
+
+        //****** Access ******//
+        [[nodiscard]] constexpr int size() const noexcept     { return m_size; }
+        [[nodiscard]] constexpr bool empty() const noexcept   { return m_size == 0; }
+
+        [[nodiscard]] const Tp* lower_bound(const Tp&) const noexcept;
+        [[nodiscard]] const Tp* find(const Tp&) const noexcept;
+
+        [[nodiscard]] bool contains(const Tp &value) const noexcept
+        { return find(value) != nullptr; }
+
+
+    private:
+        // Number of keys in one cache line; the 2^k descendants k levels below a slot are contiguous
+        static constexpr const unsigned prefetch_stride =
+                (sizeof(Tp) >= cache_line_size) ? 1 : cache_line_size / sizeof(Tp);
+
+        Tp *m_keys;     // 1-indexed; slot 0 is never constructed
+        int m_size;
+
+        void allocate();
+        template <typename Fn>
+        int build(Fn&, int, unsigned);
+
+    };  // class static_search_index
+
+
+
+    //************ Member Function Implementations ************//
+
+
+    // Tree constructor
+    template <Comparable Tp>
+    static_search_index<Tp>::static_search_index(const binary_search_tree<Tp> &tree)
+        : m_keys(nullptr),
+          m_size(tree.size())
+    {
+        if (m_size == 0) return;
+
+        auto nodes = tree.toVector(*tree.root());
+        auto at = [&nodes](const int i) -> const Tp& { return nodes[i]->m_value; };
+        allocate();
+        build(at, 0, 1);
+    }
+
+
+    // Sorted range constructor
+    template <Comparable Tp>
+    template <std::random_access_iterator It>
+    static_search_index<Tp>::static_search_index(It first, It last)
+        : m_keys(nullptr),
+          m_size(static_cast<int>(std::distance(first, last)))
+    {
+        if (m_size == 0) return;
+
+        auto at = [first](const int i) -> const Tp& { return first[i]; };
+        allocate();
+        build(at, 0, 1);
+    }
+
+
+    // Copy constructor
+    template <Comparable Tp>
+    static_search_index<Tp>::static_search_index(const static_search_index<Tp> &rhs)
+        : m_keys(nullptr),
+          m_size(rhs.m_size)
+    {
+        if (m_size == 0) return;
+
+        allocate();
+        for (auto k = 1; k <= m_size; k++)
+            ::new (static_cast<void*>(m_keys + k)) Tp(rhs.m_keys[k]);
+    }
+
+
+    // Destructor
+    template <Comparable Tp>
+    static_search_index<Tp>::~static_search_index()
+    {
+        if (m_keys == nullptr) return;
+
+        for (auto k = 1; k <= m_size; k++)
+            m_keys[k].~Tp();
+        ::operator delete(m_keys, std::align_val_t{cache_line_size});
+        m_keys = nullptr;
+    }
+
+
+    // Member swap function
+    template <Comparable Tp>
+    constexpr void static_search_index<Tp>::swap(static_search_index<Tp> &rhs) noexcept
+    {
+        using std::swap;
+        swap(rhs.m_keys, m_keys);
+        swap(rhs.m_size, m_size);
+    }
+
+
+    // Allocates uninitialized, cache-aligned storage for m_size keys plus the unused slot 0
+    template <Comparable Tp>
+    void static_search_index<Tp>::allocate()
+    {
+        m_keys = static_cast<Tp*>(::operator new((m_size + 1) * sizeof(Tp), std::align_val_t{cache_line_size}));
+    }
+
+
+    // Places the i-th smallest key (in-order) at Eytzinger slot k; returns the next unplaced rank
+    template <Comparable Tp>
+    template <typename Fn>
+    int static_search_index<Tp>::build(Fn &at, int i, const unsigned k)
+    {
+        if (k <= static_cast<unsigned>(m_size))
+        {
+            i = build(at, i, 2 * k);
+            ::new (static_cast<void*>(m_keys + k)) Tp(at(i++));
+            i = build(at, i, 2 * k + 1);
+        }
+        return i;
+    }
+
+
+    // Returns the smallest key not less than value, or nullptr if every key is less than value
+    template <Comparable Tp>
+    const Tp* static_search_index<Tp>::lower_bound(const Tp &value) const noexcept
+    {
+        const auto n = static_cast<unsigned>(m_size);
+        auto k = 1u;
+        while (k <= n)
+        {
+            // Clamped to the last slot, so no pointer is formed past the end of the array on the deepest levels
+            DS_GRAPH_PREFETCH(m_keys + std::min(k * prefetch_stride, n));
+            k = 2 * k + static_cast<unsigned>(m_keys[k] < value);
+        }
+
+        // Undo the trailing right turns plus the final left turn to recover the last slot >= value
+        k >>= std::countr_one(k) + 1;
+        return (k == 0) ? nullptr : m_keys + k;
+    }
+
+
+    // Returns the key equal to value, if it exists
+    template <Comparable Tp>
+    const Tp* static_search_index<Tp>::find(const Tp &value) const noexcept
+    {
+        const auto *lb = lower_bound(value);
+        return (lb != nullptr && *lb == value) ? lb : nullptr;
+    }
+
+
+    //************ Non-Member Function Implementations ************//
+
+
+    template <Comparable Tp>
+    constexpr void swap(static_search_index<Tp> &lhs, static_search_index<Tp> &rhs) noexcept
+    { lhs.swap(rhs); }
+
+}   // namespace nonlinear::tree
+
+
+#endif //DS_GRAPH_STATIC_SEARCH_INDEX_H
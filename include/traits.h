@@ -2,7 +2,17 @@
 #define DS_GRAPH_TRAITS_H
 
 
+#include <compare>
 #include <concepts>
+#include <cstddef>
+#include <functional>
+
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DS_GRAPH_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define DS_GRAPH_PREFETCH(addr) ((void) (addr))
+#endif
 
 
 namespace dsl::nonlinear {
@@ -19,7 +29,54 @@ namespace dsl::nonlinear {
 
     };  // concept Comparable
 
+    template <typename Tp>
+    concept Hashable = requires (Tp a)
+    {
+        { std::hash<Tp>{}(a) } -> std::convertible_to<std::size_t>;
+
+    };  // concept Hashable
+
+    // Keys that order against Tp directly, so a lookup (e.g. by std::string_view in a tree of std::string) converts nothing
+    template <typename Kp, typename Tp>
+    concept ComparableWith = requires (const Kp &key, const Tp &value)
+    {
+        { key == value } -> std::convertible_to<bool>;
+        { key <  value } -> std::convertible_to<bool>;
+        { value < key  } -> std::convertible_to<bool>;
+
+    };  // concept ComparableWith
+
+    // Stateless ordering policy: cmp(key, value) returns, in one call, a result that compares against 0 like that of <=>
+    template <typename Cmp, typename Kp, typename Tp = Kp>
+    concept ThreeWayComparator = std::default_initializable<Cmp> && requires (const Cmp &cmp, const Kp &key, const Tp &value)
+    {
+        { cmp(key, value) <  0 } -> std::convertible_to<bool>;
+        { cmp(key, value) == 0 } -> std::convertible_to<bool>;
+        { cmp(key, value) >  0 } -> std::convertible_to<bool>;
+
+    };  // concept ThreeWayComparator
+
+    // Default ordering policy of the search trees: a single <=> where the operands define one, otherwise up to two <
+    struct three_way_compare
+    {
+        template <typename Kp, typename Tp> requires std::three_way_comparable_with<Kp, Tp> || ComparableWith<Kp, Tp>
+        [[nodiscard]] constexpr auto operator()(const Kp &key, const Tp &value) const
+        {
+            if constexpr (std::three_way_comparable_with<Kp, Tp>)
+                return key <=> value;
+            else
+                return (key < value) ? std::weak_ordering::less
+                        : (value < key) ? std::weak_ordering::greater : std::weak_ordering::equivalent;
+        }
+
+    };  // struct three_way_compare
+
     static constexpr const int default_capacity = 16;
+    static constexpr const int cache_line_size = 64;
+
+    // Mixes a hash into a running seed (64-bit variant of boost::hash_combine); the result depends on order
+    [[nodiscard]] constexpr std::size_t hash_combine(const std::size_t seed, const std::size_t value) noexcept
+    { return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 12) + (seed >> 4)); }
 
 }   // namespace nonlinear
 
@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "lock_free_bst.h"
+#include "optimistic_avl_tree.h"
+
+
+namespace
+{
+    using namespace dsl::nonlinear::tree;
+
+    constexpr const int thread_count = 8;
+    constexpr const int ops_per_thread = 20000;
+    constexpr const int key_range = 512;
+
+
+    template <typename Tree>
+    class ConcurrentTreeTest : public ::testing::Test {};
+
+    using ConcurrentTrees = ::testing::Types<lock_free_bst<int>, optimistic_avl_tree<int>>;
+    TYPED_TEST_SUITE(ConcurrentTreeTest, ConcurrentTrees);
+
+
+    // Threads own disjoint key ranges, so every push and pop must succeed exactly once
+    TYPED_TEST(ConcurrentTreeTest, DisjointPushPopFind)
+    {
+        TypeParam tree;
+        constexpr const int per_thread = 2000;
+
+        auto workers { std::vector<std::thread>{} };
+        for (auto t = 0; t < thread_count; t++)
+        {
+            workers.emplace_back([&tree, t]
+            {
+                const auto base = t * per_thread;
+                for (auto i = 0; i < per_thread; i++)
+                    EXPECT_TRUE(tree.push(base + i));
+                for (auto i = 0; i < per_thread; i++)
+                    EXPECT_EQ(tree.find(base + i), base + i);
+                for (auto i = 0; i < per_thread; i += 2)
+                    EXPECT_TRUE(tree.pop(base + i));
+                for (auto i = 0; i < per_thread; i++)
+                    EXPECT_EQ(tree.contains(base + i), i % 2 == 1);
+            });
+        }
+        for (auto &w : workers)
+            w.join();
+
+        EXPECT_EQ(tree.size(), thread_count * per_thread / 2);
+        for (auto k = 0; k < thread_count * per_thread; k++)
+            EXPECT_EQ(tree.contains(k), k % 2 == 1);
+    }
+
+
+    // Threads race on one small key range; for each key, the successful pushes and pops must alternate,
+    // so their difference is 0 or 1 and matches whether the key is present at the end
+    TYPED_TEST(ConcurrentTreeTest, ContendedPushPopFind)
+    {
+        TypeParam tree;
+        auto pushes { std::vector<std::atomic<int>>(key_range) };
+        auto pops { std::vector<std::atomic<int>>(key_range) };
+
+        auto workers { std::vector<std::thread>{} };
+        for (auto t = 0; t < thread_count; t++)
+        {
+            workers.emplace_back([&, t]
+            {
+                auto rng { std::mt19937{static_cast<unsigned>(t + 1)} };
+                auto pick { std::uniform_int_distribution<int>{0, key_range - 1} };
+                for (auto i = 0; i < ops_per_thread; i++)
+                {
+                    const auto key = pick(rng);
+                    switch (rng() % 3)
+                    {
+                        case 0:
+                            if (tree.push(key))
+                                pushes[key].fetch_add(1, std::memory_order_relaxed);
+                            break;
+                        case 1:
+                            if (tree.pop(key))
+                                pops[key].fetch_add(1, std::memory_order_relaxed);
+                            break;
+                        default:
+                            if (auto found = tree.find(key))
+                                EXPECT_EQ(*found, key);
+                            break;
+                    }
+                }
+            });
+        }
+        for (auto &w : workers)
+            w.join();
+
+        auto present = 0;
+        for (auto k = 0; k < key_range; k++)
+        {
+            const auto net = pushes[k].load() - pops[k].load();
+            ASSERT_TRUE(net == 0 || net == 1) << "key " << k;
+            EXPECT_EQ(tree.contains(k), net == 1) << "key " << k;
+            present += net;
+        }
+        EXPECT_EQ(tree.size(), present);
+    }
+
+
+    // Readers keep finding a fixed set of keys while writers churn the keys around them
+    TYPED_TEST(ConcurrentTreeTest, ReadersSeeStableKeysDuringChurn)
+    {
+        TypeParam tree;
+        for (auto k = 0; k < key_range; k += 2)
+            tree.push(k);
+
+        auto done { std::atomic<bool>{false} };
+        auto readers { std::vector<std::thread>{} };
+        for (auto t = 0; t < thread_count / 2; t++)
+        {
+            readers.emplace_back([&]
+            {
+                while (!done.load(std::memory_order_acquire))
+                    for (auto k = 0; k < key_range; k += 2)
+                        ASSERT_TRUE(tree.contains(k)) << "key " << k;
+            });
+        }
+
+        auto writers { std::vector<std::thread>{} };
+        for (auto t = 0; t < thread_count / 2; t++)
+        {
+            writers.emplace_back([&tree, t]
+            {
+                for (auto round = 0; round < ops_per_thread / key_range; round++)
+                {
+                    for (auto k = 1 + 2 * t; k < key_range; k += thread_count)
+                        tree.push(k);
+                    for (auto k = 1 + 2 * t; k < key_range; k += thread_count)
+                        tree.pop(k);
+                }
+            });
+        }
+        for (auto &w : writers)
+            w.join();
+        done.store(true, std::memory_order_release);
+        for (auto &r : readers)
+            r.join();
+
+        EXPECT_EQ(tree.size(), key_range / 2);
+    }
+
+}   // namespace
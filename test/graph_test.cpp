@@ -0,0 +1,144 @@
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "digraph.h"
+
+
+namespace
+{
+    using namespace dsl::nonlinear::graph;
+
+
+    // Long enough to live on the heap, so a moved-from string is observably empty
+    std::string vertex(const char *name)
+    { return std::string(name) + std::string(40, '-'); }
+
+
+
+    //****** Vertices ******//
+
+    TEST(DigraphVertices, PushVertexCopiesOrMoves)
+    {
+        digraph<std::string> graph(4);
+
+        const auto kept = vertex("a");
+        EXPECT_TRUE(graph.push_vertex(kept));
+        EXPECT_EQ(kept, vertex("a"));
+
+        auto moved = vertex("b");
+        EXPECT_TRUE(graph.push_vertex(std::move(moved), 3));
+        EXPECT_TRUE(moved.empty());
+
+        EXPECT_EQ(graph.size(), 2);
+        EXPECT_TRUE(graph.contains(vertex("a")));
+        EXPECT_TRUE(graph.contains(vertex("b")));
+
+        // A duplicate is rejected
+        EXPECT_FALSE(graph.push_vertex(vertex("a")));
+        EXPECT_EQ(graph.size(), 2);
+    }
+
+
+    TEST(DigraphVertices, EmplaceVertexBuildsTheValue)
+    {
+        digraph<std::string> graph(2);
+        EXPECT_TRUE(graph.emplace_vertex(3, 'x'));
+        EXPECT_TRUE(graph.contains("xxx"));
+
+        EXPECT_FALSE(graph.emplace_vertex("xxx"));
+        EXPECT_TRUE(graph.emplace_vertex("y"));
+
+        // The graph is full
+        EXPECT_FALSE(graph.emplace_vertex("z"));
+        EXPECT_EQ(graph.size(), 2);
+    }
+
+
+
+    //****** Edges ******//
+
+    TEST(DigraphEdges, PushEdgeBetweenNewVertices)
+    {
+        digraph<std::string> graph(4);
+
+        auto start = vertex("a"), end = vertex("b");
+        EXPECT_TRUE(graph.push_edge(std::move(start), std::move(end)));
+        EXPECT_TRUE(start.empty());
+        EXPECT_TRUE(end.empty());
+
+        EXPECT_EQ(graph.size(), 2);
+        EXPECT_TRUE(graph.has_link(vertex("a"), vertex("b")));
+        EXPECT_TRUE(graph.has_link(vertex("b"), vertex("a")));
+    }
+
+
+    TEST(DigraphEdges, PushEdgeToOneNewVertex)
+    {
+        digraph<std::string> graph(4);
+        ASSERT_TRUE(graph.push_vertex(vertex("a")));
+
+        auto start = vertex("a"), end = vertex("b");
+        EXPECT_TRUE(graph.push_edge(std::move(start), std::move(end)));
+
+        // Only the value that becomes a new vertex is consumed
+        EXPECT_EQ(start, vertex("a"));
+        EXPECT_TRUE(end.empty());
+
+        EXPECT_EQ(graph.size(), 2);
+        EXPECT_TRUE(graph.has_link(vertex("b"), vertex("a")));
+    }
+
+
+    TEST(DigraphEdges, PushEdgeBetweenExistingVertices)
+    {
+        digraph<int> graph(4);
+        ASSERT_TRUE(graph.push_vertex(1));
+        ASSERT_TRUE(graph.push_vertex(2));
+
+        EXPECT_TRUE(graph.push_edge(1, 2));
+        EXPECT_EQ(graph.size(), 2);
+        EXPECT_TRUE(graph.has_link(1, 2));
+        EXPECT_TRUE(graph.has_link(2, 1));
+    }
+
+
+
+    //****** Traversal and Removal ******//
+
+    TEST(DigraphTraversal, SearchesDegreesAndRemoval)
+    {
+        digraph<int> graph(8);
+        ASSERT_TRUE(graph.push_edge(1, 2));
+        ASSERT_TRUE(graph.push_edge(2, 3));
+        ASSERT_TRUE(graph.try_link(1, 3));
+        ASSERT_TRUE(graph.push_vertex(9));
+
+        ASSERT_NE(graph.find_bfs(3), nullptr);
+        EXPECT_EQ(graph.find_bfs(3)->m_value, 3);
+        EXPECT_EQ(graph.find_dfs(3), graph.find_bfs(3));
+        EXPECT_EQ(graph.find_bfs(9), nullptr);     // not reachable from the root
+        EXPECT_EQ(graph.count_disconnected(), 1);
+
+        EXPECT_EQ(graph.out_degree(1), 2);
+        EXPECT_EQ(graph.in_degree(2), 2);
+        EXPECT_FALSE(graph.try_link(1, 3));     // already linked
+
+        auto copy = graph;
+        EXPECT_TRUE(graph.pop_vertex(3));
+        EXPECT_FALSE(graph.contains(3));
+        EXPECT_EQ(graph.out_degree(1), 1);
+        EXPECT_EQ(graph.size(), 3);
+
+        // The copy keeps its own adjacency lists
+        EXPECT_EQ(copy.out_degree(1), 2);
+        EXPECT_TRUE(copy.has_link(3, 2));
+
+        auto os { std::ostringstream{} };
+        os << graph;
+        EXPECT_EQ(os.str(), "1 2 ");
+    }
+
+}   // namespace
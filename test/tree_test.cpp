@@ -0,0 +1,556 @@
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "avl_tree.h"
+#include "compact_search_tree.h"
+#include "persistent_avl_tree.h"
+
+
+namespace
+{
+    using namespace dsl::nonlinear::tree;
+
+
+    // Returns the keys of a search tree in ascending order
+    template <typename Tree>
+    std::vector<int> keys_of(const Tree &tree)
+    {
+        auto keys { std::vector<int>{} };
+        tree.for_each_in_range(std::numeric_limits<int>::min(), std::numeric_limits<int>::max(),
+                               [&keys](const int key) { keys.push_back(key); });
+        return keys;
+    }
+
+
+    // Fills a tree and a reference set with the same count random keys drawn from [0, range)
+    template <typename Tree>
+    void fill_random(Tree &tree, std::set<int> &reference, const int count, const int range, const unsigned seed)
+    {
+        auto rng { std::mt19937{seed} };
+        auto pick { std::uniform_int_distribution<int>{0, range - 1} };
+        for (auto i = 0; i < count; i++)
+        {
+            const auto key = pick(rng);
+            EXPECT_EQ(tree.push(key), reference.insert(key).second);
+        }
+    }
+
+
+    // Checks a tree against a reference set: same keys in order, same size, and still AVL-balanced
+    void expect_matches(const avl_tree<int> &tree, const std::set<int> &reference)
+    {
+        EXPECT_EQ(keys_of(tree), std::vector<int>(reference.begin(), reference.end()));
+        EXPECT_EQ(tree.size(), static_cast<int>(reference.size()));
+        EXPECT_TRUE(tree.is_balanced(tree.root()));
+    }
+
+
+    // Returns the values of any binary tree in pre-order, which pins down its shape as well as its values
+    template <typename Tp>
+    std::vector<Tp> pre_order_of(const binary_tree<Tp> &tree)
+    {
+        auto values { std::vector<Tp>{} };
+        auto stack { std::vector<const typename binary_tree<Tp>::bitree_node*>{} };
+        if (tree.root() != nullptr)
+            stack.push_back(tree.root());
+
+        while (!stack.empty())
+        {
+            const auto *node = stack.back();
+            stack.pop_back();
+            values.push_back(node->m_value);
+            if (node->m_right != nullptr)
+                stack.push_back(node->m_right);
+            if (node->m_left != nullptr)
+                stack.push_back(node->m_left);
+        }
+        return values;
+    }
+
+
+
+    //****** Copying ******//
+
+    TEST(TreeCopy, CopyHasTheSameShapeAndIsIndependent)
+    {
+        avl_tree<int> source;
+        auto reference { std::set<int>{} };
+        fill_random(source, reference, 2000, 5000, 11);
+
+        auto copy = source;
+        EXPECT_EQ(pre_order_of(copy), pre_order_of(source));
+        expect_matches(copy, reference);
+
+        // The copy's nodes share one arena, but popping them one by one must still work
+        auto copy_keys = reference;
+        for (auto k = 0; k < 5000; k += 3)
+            EXPECT_EQ(copy.pop(k), copy_keys.erase(k) == 1);
+        for (auto k = 5000; k < 5100; k++)
+        {
+            copy.push(k);
+            copy_keys.insert(k);
+        }
+
+        expect_matches(copy, copy_keys);
+        expect_matches(source, reference);
+    }
+
+
+    TEST(TreeCopy, CopyOutlivesItsSourceAndCopiesAgain)
+    {
+        auto *source = new binary_search_tree<std::string>();
+        for (const auto *word : {"m", "f", "t", "b", "h", "p", "w", "a", "c"})
+            source->push(std::string(word) + std::string(40, '.'));     // past the small-string buffer
+
+        auto copy { binary_search_tree<std::string>(*source) };
+        const auto expected = pre_order_of(*source);
+        delete source;
+
+        auto second = copy;
+        EXPECT_EQ(pre_order_of(copy), expected);
+        EXPECT_EQ(pre_order_of(second), expected);
+
+        binary_search_tree<std::string> empty;
+        auto empty_copy = empty;
+        EXPECT_EQ(empty_copy.size(), 0);
+        EXPECT_EQ(empty_copy.root(), nullptr);
+    }
+
+
+    //****** Traversal ******//
+
+    TEST(TreeTraversal, ConstTraversalsLeaveTheTreeUntouched)
+    {
+        // A chain deeper than the node stack's inline capacity, so its overflow path runs too
+        binary_search_tree<int> chain;
+        auto expected { std::string{} };
+        for (auto k = 0; k < 200; k++)
+        {
+            chain.push(k);
+            expected += std::to_string(k);
+        }
+
+        const auto &tree = chain;
+        const auto shape = pre_order_of(tree);
+        auto in { std::ostringstream{} }, pre { std::ostringstream{} };
+        tree.in_order(tree.root(), in);
+        tree.pre_order(tree.root(), pre);
+
+        EXPECT_EQ(in.str(), expected);
+        EXPECT_EQ(pre.str(), expected);
+        EXPECT_EQ(pre_order_of(tree), shape);
+    }
+
+
+    TEST(TreeTraversal, ConcurrentReadersShareAConstTree)
+    {
+        avl_tree<int> source;
+        auto reference { std::set<int>{} };
+        fill_random(source, reference, 2000, 5000, 5);
+
+        auto expected { std::ostringstream{} };
+        for (const auto key : reference)
+            expected << key;
+
+        const auto &tree = source;
+        auto readers { std::vector<std::thread>{} };
+        for (auto t = 0; t < 4; t++)
+        {
+            readers.emplace_back([&tree, &expected]
+            {
+                for (auto round = 0; round < 20; round++)
+                {
+                    auto os { std::ostringstream{} };
+                    tree.in_order(tree.root(), os);
+                    EXPECT_EQ(os.str(), expected.str());
+                }
+            });
+        }
+        for (auto &r : readers)
+            r.join();
+    }
+
+
+
+    //****** Order Statistics ******//
+
+    TEST(AvlOrderStatistics, SelectRankAndCountRangeMatchStdSet)
+    {
+        avl_tree<int> tree;
+        auto reference { std::set<int>{} };
+        auto rng { std::mt19937{7} };
+        auto pick { std::uniform_int_distribution<int>{0, 1999} };
+
+        // Interleave pushes and pops so the subtree counts go through every rotation case
+        for (auto i = 0; i < 5000; i++)
+        {
+            const auto key = pick(rng);
+            if (rng() % 3 == 0)
+                EXPECT_EQ(tree.pop(key), reference.erase(key) == 1);
+            else
+                EXPECT_EQ(tree.push(key), reference.insert(key).second);
+        }
+
+        const auto sorted { std::vector<int>(reference.begin(), reference.end()) };
+        ASSERT_EQ(tree.size(), static_cast<int>(sorted.size()));
+        for (auto i = 0; i < static_cast<int>(sorted.size()); i++)
+            EXPECT_EQ(tree.select(i), sorted[i]);
+
+        for (auto key = -1; key <= 2000; key++)
+        {
+            const auto below = std::distance(reference.begin(), reference.lower_bound(key));
+            EXPECT_EQ(tree.rank(key), below) << "key " << key;
+        }
+
+        for (auto i = 0; i < 500; i++)
+        {
+            auto lo = pick(rng), hi = pick(rng);
+            if (i % 10 == 0)
+                std::swap(lo, hi);      // an empty range when lo > hi
+
+            const auto expected = (hi < lo) ? 0 : std::distance(reference.lower_bound(lo), reference.upper_bound(hi));
+            EXPECT_EQ(tree.count_range(lo, hi), expected) << "[" << lo << ", " << hi << "]";
+        }
+    }
+
+
+    TEST(AvlOrderStatistics, SelectThrowsOutsideTheTree)
+    {
+        avl_tree<int> tree;
+        EXPECT_THROW(static_cast<void>(tree.select(0)), std::out_of_range);
+
+        for (auto k = 0; k < 10; k++)
+            tree.push(k);
+        EXPECT_THROW(static_cast<void>(tree.select(-1)), std::out_of_range);
+        EXPECT_THROW(static_cast<void>(tree.select(10)), std::out_of_range);
+        EXPECT_EQ(tree.select(9), 9);
+    }
+
+
+    //****** Set Operations ******//
+
+    TEST(AvlSetOperations, SplitKeepsLowerKeysAndReturnsTheRest)
+    {
+        for (const auto pivot : {-1, 0, 250, 499, 1000})
+        {
+            avl_tree<int> tree;
+            auto reference { std::set<int>{} };
+            fill_random(tree, reference, 400, 500, 1);
+
+            auto upper = tree.split(pivot);
+            auto split_at = reference.lower_bound(pivot);
+            expect_matches(tree, std::set<int>(reference.begin(), split_at));
+            expect_matches(upper, std::set<int>(split_at, reference.end()));
+        }
+    }
+
+
+    TEST(AvlSetOperations, JoinAppendsGreaterKeys)
+    {
+        avl_tree<int> lower, upper;
+        auto reference { std::set<int>{} };
+        for (auto k = 0; k < 300; k++)
+        {
+            lower.push(k);
+            reference.insert(k);
+        }
+        for (auto k = 300; k < 310; k++)
+        {
+            upper.push(k);
+            reference.insert(k);
+        }
+
+        lower.join(std::move(upper));
+        expect_matches(lower, reference);
+
+        avl_tree<int> empty;
+        empty.join(std::move(lower));
+        expect_matches(empty, reference);
+    }
+
+
+    TEST(AvlSetOperations, UnionIntersectionAndDifferenceMatchStdSet)
+    {
+        for (auto seed = 1u; seed <= 5; seed++)
+        {
+            avl_tree<int> lhs, rhs;
+            auto lhs_keys { std::set<int>{} }, rhs_keys { std::set<int>{} };
+            fill_random(lhs, lhs_keys, 600, 1000, seed);
+            fill_random(rhs, rhs_keys, 300 * static_cast<int>(seed), 1000, seed + 100);
+
+            auto expected { std::set<int>{} };
+
+            // A low cutoff makes the union fork onto the pool even at this size
+            auto united = lhs;
+            united.parallel_cutoff(64);
+            united.union_with(rhs);
+            std::set_union(lhs_keys.begin(), lhs_keys.end(), rhs_keys.begin(), rhs_keys.end(),
+                           std::inserter(expected, expected.end()));
+            expect_matches(united, expected);
+
+            expected.clear();
+            auto common = lhs;
+            common.intersect_with(rhs);
+            std::set_intersection(lhs_keys.begin(), lhs_keys.end(), rhs_keys.begin(), rhs_keys.end(),
+                                  std::inserter(expected, expected.end()));
+            expect_matches(common, expected);
+
+            expected.clear();
+            auto only_lhs = lhs;
+            only_lhs.difference_with(std::move(rhs));
+            std::set_difference(lhs_keys.begin(), lhs_keys.end(), rhs_keys.begin(), rhs_keys.end(),
+                                std::inserter(expected, expected.end()));
+            expect_matches(only_lhs, expected);
+
+            // The operands that were copied from are left untouched
+            expect_matches(lhs, lhs_keys);
+        }
+    }
+
+
+
+    //****** Compact Trees ******//
+
+    TEST(CompactSearchTree, ChurnMatchesStdSet)
+    {
+        compact_search_tree<int> tree;
+        auto reference { std::set<int>{} };
+        auto rng { std::mt19937{9} };
+        for (auto i = 0; i < 50000; i++)
+        {
+            const auto key = static_cast<int>(rng() % 4000);
+            if (rng() % 2 == 0)
+                EXPECT_EQ(tree.pop(key), reference.erase(key) == 1);
+            else
+                EXPECT_EQ(tree.push(key), reference.insert(key).second);
+        }
+
+        auto values { std::vector<int>{} };
+        tree.for_each([&values](const int value) { values.push_back(value); });
+        EXPECT_EQ(values, std::vector<int>(reference.begin(), reference.end()));
+        for (auto k = 0; k < 4000; k++)
+            EXPECT_EQ(tree.contains(k), reference.contains(k));
+    }
+
+
+    TEST(CompactSearchTree, SortedPushesAndFullDrain)
+    {
+        compact_search_tree<int> tree;
+        for (auto k = 0; k < 20000; k++)
+            EXPECT_TRUE(tree.push(k));
+        for (auto k = 0; k < 20000; k += 2)
+            EXPECT_TRUE(tree.pop(k));
+        for (auto k = 0; k < 20000; k++)
+            EXPECT_EQ(tree.contains(k), k % 2 == 1);
+
+        for (auto k = 19999; k > 0; k -= 2)
+            EXPECT_TRUE(tree.pop(k));
+        EXPECT_TRUE(tree.empty());
+        EXPECT_TRUE(tree.push(7));
+        EXPECT_NE(tree.find(7), nullptr);
+    }
+
+
+
+    //****** Persistent Trees ******//
+
+    // Orders keys from greatest to least with one three-way comparison
+    struct descending
+    {
+        template <typename Kp, typename Tp>
+        [[nodiscard]] constexpr auto operator()(const Kp &key, const Tp &value) const
+        { return value <=> key; }
+    };
+
+
+    TEST(PersistentAvlTree, ComparePolicyOrdersEveryOperation)
+    {
+        persistent_avl_tree<int, descending> tree;
+        auto reference { std::set<int, std::greater<>>{} };
+        auto rng { std::mt19937{3} };
+        for (auto i = 0; i < 3000; i++)
+        {
+            const auto key = static_cast<int>(rng() % 1000);
+            if (rng() % 3 == 0)
+                EXPECT_EQ(tree.pop(key), reference.erase(key) == 1);
+            else
+                EXPECT_EQ(tree.push(key), reference.insert(key).second);
+        }
+
+        const auto snapshot = tree.snapshot();
+        auto values { std::vector<int>{} };
+        tree.for_each([&values](const int value) { values.push_back(value); });
+        EXPECT_EQ(values, std::vector<int>(reference.begin(), reference.end()));
+
+        for (auto k = 0; k < 1000; k++)
+        {
+            EXPECT_EQ(tree.contains(k), reference.contains(k));
+            EXPECT_EQ(tree.rank(k), static_cast<int>(std::distance(reference.begin(), reference.lower_bound(k))));
+        }
+        EXPECT_EQ(tree.select(0), *reference.begin());
+
+        tree.pop(*reference.begin());
+        EXPECT_NE(tree, snapshot);
+        EXPECT_EQ(snapshot.size(), static_cast<int>(reference.size()));
+    }
+
+
+    TEST(PersistentAvlTree, FindsStringsByViewWithoutConverting)
+    {
+        persistent_avl_tree<std::string> tree;
+        for (const auto *word : {"pear", "apple", "fig", "plum", "kiwi"})
+            tree.emplace(word);
+
+        const auto *found = tree.find(std::string_view{"fig"});
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(*found, "fig");
+        EXPECT_FALSE(tree.contains(std::string_view{"grape"}));
+        EXPECT_EQ(tree.rank(std::string_view{"orange"}), 3);
+    }
+
+
+
+    //****** Slab Allocation ******//
+
+    TEST(TreeSlab, ChurnReusesReleasedSlotsCorrectly)
+    {
+        avl_tree<int> tree;
+        tree.enable_slab();
+        auto reference { std::set<int>{} };
+        auto rng { std::mt19937{3} };
+        auto pick { std::uniform_int_distribution<int>{0, 3999} };
+
+        for (auto i = 0; i < 200000; i++)
+        {
+            const auto key = pick(rng);
+            if (rng() % 2 == 0)
+                EXPECT_EQ(tree.pop(key), reference.erase(key) == 1);
+            else
+                EXPECT_EQ(tree.push(key), reference.insert(key).second);
+        }
+
+        EXPECT_TRUE(tree.slab_enabled());
+        expect_matches(tree, reference);
+    }
+
+
+    TEST(TreeSlab, CopyOfSlabTreeGetsItsOwnSlab)
+    {
+        auto *source = new avl_tree<int>();
+        source->enable_slab();
+        auto reference { std::set<int>{} };
+        fill_random(*source, reference, 3000, 10000, 5);
+
+        auto copy = *source;
+        EXPECT_TRUE(copy.slab_enabled());
+        EXPECT_EQ(pre_order_of(copy), pre_order_of(*source));
+        delete source;
+
+        for (auto k = 0; k < 10000; k += 2)
+        {
+            copy.pop(k);
+            reference.erase(k);
+        }
+        for (auto k = 10000; k < 11000; k++)
+        {
+            copy.push(k);
+            reference.insert(k);
+        }
+        expect_matches(copy, reference);
+    }
+
+
+    TEST(TreeSlab, SplitAndJoinAcrossSlabs)
+    {
+        for (const auto upper_has_slab : {false, true})
+        {
+            avl_tree<int> tree;
+            tree.enable_slab();
+            auto reference { std::set<int>{} };
+            fill_random(tree, reference, 2000, 4000, 9);
+
+            auto upper = tree.split(2000);
+            if (upper_has_slab)
+                upper.enable_slab();
+
+            // Both halves keep allocating after the split; their nodes now come from either slab
+            for (auto k = 0; k < 4000; k += 7)
+                EXPECT_EQ(((k < 2000) ? tree : upper).push(k), reference.insert(k).second);
+
+            tree.join(std::move(upper));
+            expect_matches(tree, reference);
+
+            avl_tree<int> other;
+            other.enable_slab();
+            auto other_keys { std::set<int>{} };
+            fill_random(other, other_keys, 500, 8000, 10);
+            tree.union_with(std::move(other));
+            reference.insert(other_keys.begin(), other_keys.end());
+            expect_matches(tree, reference);
+        }
+    }
+
+
+    TEST(TreeSlab, SplitHalfOutlivesTheSlabOwner)
+    {
+        auto upper { avl_tree<int>{} };
+        auto reference { std::set<int>{} };
+        {
+            avl_tree<int> tree;
+            tree.enable_slab();
+            fill_random(tree, reference, 2000, 4000, 12);
+            upper = tree.split(1000);
+        }
+
+        reference.erase(reference.begin(), reference.lower_bound(1000));
+        expect_matches(upper, reference);
+        for (auto k = 1000; k < 4000; k += 5)
+            EXPECT_EQ(upper.pop(k), reference.erase(k) == 1);
+        expect_matches(upper, reference);
+    }
+
+
+    TEST(TreeSlab, ClearFreesAndStartsOver)
+    {
+        avl_tree<int> tree;
+        tree.enable_slab();
+        auto reference { std::set<int>{} };
+
+        for (auto round = 0; round < 3; round++)
+        {
+            fill_random(tree, reference, 5000, 20000, 20 + round);
+            expect_matches(tree, reference);
+
+            // Alternate the bulk-free path with a parallel teardown at a low cutoff
+            tree.parallel_cutoff((round % 2 == 0) ? dsl::nonlinear::default_parallel_cutoff : 64);
+            tree.clear(round % 2 == 1);
+            reference.clear();
+            EXPECT_EQ(tree.size(), 0);
+            EXPECT_EQ(tree.root(), nullptr);
+            EXPECT_TRUE(tree.slab_enabled());
+        }
+
+        avl_tree<std::string> words;
+        words.enable_slab();
+        for (auto i = 0; i < 1000; i++)
+            words.push(std::to_string(i) + std::string(40, '#'));
+        words.clear();
+        words.push("after clear");
+        EXPECT_EQ(words.size(), 1);
+        EXPECT_NE(words.find("after clear"), nullptr);
+    }
+
+}   // namespace